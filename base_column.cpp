@@ -1,6 +1,7 @@
 
 #include <core/base_column.hpp>
 #include <core/column.hpp>
+#include <core/position_interval_list.hpp>
 #include <iostream>
 
 using namespace std;
@@ -13,6 +14,29 @@ namespace CoGaDB{
 
 	ColumnBase::~ColumnBase(){}
 
+	bool ColumnBase::update(PositionIntervalListPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		if(new_value.empty()) return false;
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			for(TID tid=it->first;tid<it->second;++tid){
+				if(!update(tid,new_value)) return false;
+			}
+		}
+		return true;
+	}
+
+	bool ColumnBase::remove(PositionIntervalListPtr tids){
+		if(!tids) return false;
+		if(tids->empty()) return false;
+		//removing from the back keeps the tids in front valid
+		for(PositionIntervalList::const_reverse_iterator it=tids->rbegin();it!=tids->rend();++it){
+			for(TID tid=it->second;tid>it->first;--tid){
+				if(!remove(tid-1)) return false;
+			}
+		}
+		return true;
+	}
+
 	AttributeType ColumnBase::getType() const throw(){
 		return db_type_;
 	}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This class stores unsigned integers with a fixed number of bits per value, which are packed into 64 bit words.
+ *  \details   Values may span two words. The number of bits per value can be changed later on, which repacks all values.
+ */
+class BitPackedVector{
+	public:
+	typedef unsigned int value_type;
+	typedef boost::uint64_t Word;
+	/***************** constructors and destructor *****************/
+	explicit BitPackedVector(unsigned int bits_per_value=1);
+
+	inline value_type operator[](size_t index) const;
+	inline void set(size_t index, value_type value);
+	void push_back(value_type value);
+	/*! \brief removes the value on position index, all following values move one position to the front*/
+	void erase(size_t index);
+	void clear();
+	void reserve(size_t number_of_values);
+	/*! \brief changes the number of values, new values are zero
+	 *  \details values in disjoint ranges whose boundaries are multiples of 64 live in disjoint words,
+	 *  so such ranges may be written concurrently with set()*/
+	void resize(size_t number_of_values);
+	size_t size() const throw();
+	bool empty() const throw();
+
+	unsigned int getBitsPerValue() const throw();
+	/*! \brief changes the number of bits per value and repacks the content
+	 *  \details the caller has to ensure that all values fit into the new number of bits*/
+	void setBitsPerValue(unsigned int bits_per_value);
+	/*! \brief appends the positions in [begin,end) whose value lies in [lower,upper) to result*/
+	template<class PositionType>
+	void findRange(value_type lower, value_type upper, size_t begin, size_t end, std::vector<PositionType>& result) const;
+	/*! \brief returns the size in bytes the packed values consume in main memory*/
+	size_t getSizeinBytes() const throw();
+
+	/*! \brief returns the number of bits that is required to distinguish number_of_values different values (at least one)*/
+	static unsigned int bitsFor(size_t number_of_values);
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & bits_;
+		ar & size_;
+		ar & words_;
+		mask_ = maskFor(bits_);
+	}
+
+	static Word maskFor(unsigned int bits);
+	size_t wordsFor(size_t number_of_values) const;
+
+	std::vector<Word> words_;
+	unsigned int bits_;
+	boost::uint64_t size_;
+	Word mask_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	inline BitPackedVector::BitPackedVector(unsigned int bits_per_value) : words_(), bits_(bits_per_value), size_(0), mask_(maskFor(bits_per_value)){
+
+	}
+
+	inline BitPackedVector::value_type BitPackedVector::operator[](size_t index) const{
+		const Word bit = Word(index)*bits_;
+		const size_t word = size_t(bit >> 6);
+		const unsigned int offset = unsigned(bit & 63);
+		Word value = words_[word] >> offset;
+		//the value continues in the next word
+		if(offset+bits_>64){
+			value |= words_[word+1] << (64-offset);
+		}
+		return value_type(value & mask_);
+	}
+
+	inline void BitPackedVector::set(size_t index, value_type value){
+		const Word bit = Word(index)*bits_;
+		const size_t word = size_t(bit >> 6);
+		const unsigned int offset = unsigned(bit & 63);
+		const Word v = Word(value) & mask_;
+		words_[word] = (words_[word] & ~(mask_ << offset)) | (v << offset);
+		if(offset+bits_>64){
+			const unsigned int shift = 64-offset;
+			words_[word+1] = (words_[word+1] & ~(mask_ >> shift)) | (v >> shift);
+		}
+	}
+
+	inline void BitPackedVector::push_back(value_type value){
+		if(words_.size()<wordsFor(size_+1)){
+			words_.push_back(0);
+		}
+		++size_;
+		set(size_-1,value);
+	}
+
+	inline void BitPackedVector::erase(size_t index){
+		for(size_t i=index;i+1<size_;++i){
+			set(i,(*this)[i+1]);
+		}
+		--size_;
+		words_.resize(wordsFor(size_));
+	}
+
+	inline void BitPackedVector::clear(){
+		words_.clear();
+		size_=0;
+	}
+
+	inline void BitPackedVector::reserve(size_t number_of_values){
+		words_.reserve(wordsFor(number_of_values));
+	}
+
+	inline void BitPackedVector::resize(size_t number_of_values){
+		//clear the bits behind the last value, so that growing yields zeros
+		const unsigned int used_bits = unsigned((size_*bits_) & 63);
+		if(number_of_values>size_ && used_bits!=0){
+			words_.back() &= maskFor(used_bits);
+		}
+		words_.resize(wordsFor(number_of_values),0);
+		size_=number_of_values;
+	}
+
+	inline size_t BitPackedVector::size() const throw(){
+		return size_t(size_);
+	}
+
+	inline bool BitPackedVector::empty() const throw(){
+		return size_==0;
+	}
+
+	inline unsigned int BitPackedVector::getBitsPerValue() const throw(){
+		return bits_;
+	}
+
+	inline void BitPackedVector::setBitsPerValue(unsigned int bits_per_value){
+		if(bits_per_value==bits_) return;
+		BitPackedVector repacked(bits_per_value);
+		repacked.words_.resize(repacked.wordsFor(size_));
+		repacked.size_=size_;
+		for(size_t i=0;i<size_;++i){
+			repacked.set(i,(*this)[i]);
+		}
+		std::swap(words_,repacked.words_);
+		bits_=bits_per_value;
+		mask_=repacked.mask_;
+	}
+
+	template<class PositionType>
+	void BitPackedVector::findRange(value_type lower, value_type upper, size_t begin, size_t end, std::vector<PositionType>& result) const{
+		if(lower>=upper) return;
+		//a single unsigned comparison checks both boundaries
+		const Word width = Word(upper)-lower;
+		//the positions are written without branches into a buffer, which is flushed block wise
+		const size_t block_size=1024;
+		PositionType buffer[block_size];
+		Word bit = Word(begin)*bits_;
+		for(size_t block_begin=begin;block_begin<end;block_begin+=block_size){
+			const size_t block_end = std::min(end,block_begin+block_size);
+			size_t number_of_matches=0;
+			for(size_t i=block_begin;i<block_end;++i,bit+=bits_){
+				const size_t word = size_t(bit >> 6);
+				const unsigned int offset = unsigned(bit & 63);
+				Word value = words_[word] >> offset;
+				if(offset+bits_>64){
+					value |= words_[word+1] << (64-offset);
+				}
+				buffer[number_of_matches] = PositionType(i);
+				number_of_matches += ((value & mask_)-lower) < width;
+			}
+			result.insert(result.end(),buffer,buffer+number_of_matches);
+		}
+	}
+
+	inline size_t BitPackedVector::getSizeinBytes() const throw(){
+		return words_.capacity()*sizeof(Word);
+	}
+
+	inline unsigned int BitPackedVector::bitsFor(size_t number_of_values){
+		unsigned int bits=1;
+		while(bits<32 && (size_t(1) << bits)<number_of_values){
+			++bits;
+		}
+		return bits;
+	}
+
+	inline BitPackedVector::Word BitPackedVector::maskFor(unsigned int bits){
+		return (Word(1) << bits)-1;
+	}
+
+	inline size_t BitPackedVector::wordsFor(size_t number_of_values) const{
+		return size_t((Word(number_of_values)*bits_+63)/64);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
@@ -18,6 +18,11 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <core/position_interval_list.hpp>
+#include <compression/delta_codec.hpp>
+#include <compression/frame_of_reference_codec.hpp>
+#include <compression/varint_delta_codec.hpp>
+#include <compression/xor_float_codec.hpp>
 
 //#include <boost/lexical_cast.hpp>
 
@@ -25,29 +30,42 @@ namespace CoGaDB{
 	
 
 /*!
- *  \brief     This class represents a dictionary compressed column with type T, is the base class for all compressed typed column classes.
+ *  \brief     This class represents a delta compressed column with type T, which stores the difference of every value to its predecessor.
+ *  \details   The rows are stored by a DeltaCodec. Integer columns use a FrameOfReferenceDeltaCodec, which bit-packs the deltas of blocks of rows,
+ *             or with VARIABLE_LENGTH_DELTAS a VarintDeltaCodec, which stores every delta in as few bytes as possible. Float columns store the
+ *             XOR of neighbouring values in a XorFloatCodec, so no value is rounded. Other columns store every delta as a value of type T in
+ *             PlainDeltaBlocks. All codecs store an absolute value per block, so the value of a row is decoded from its block only.
  */	
 template<class T>
 class DeltaCompressedColumn : public CompressedColumn<T>{
 	public:
 	/***************** constructors and destructor *****************/
-	DeltaCompressedColumn(const std::string& name, AttributeType db_type);
+	DeltaCompressedColumn(const std::string& name, AttributeType db_type, DeltaEncoding encoding=FIXED_LENGTH_DELTAS);
+	/*! \brief copies the content of the codec*/
+	DeltaCompressedColumn(const DeltaCompressedColumn<T>& column);
 	virtual ~DeltaCompressedColumn();
 
 	virtual bool insert(const boost::any& new_Value);
 	virtual bool insert(const T& new_value);
+	/*! \brief returns the value of the row on position index, decodes the deltas in front of index in its block*/
 	virtual T decompress(const int index);
 	//virtual bool insert(const std::string& new_value);
 	
 	template <typename InputIterator>
 	bool insert(InputIterator first, InputIterator last);
 
+	/*! \brief updates the row in its block, the other blocks are not decoded*/
 	virtual bool update(TID tid, const boost::any& new_value);
 	virtual bool update(PositionListPtr tid, const boost::any& new_value);	
+	/*! \brief replaces the rows of all intervals block by block, every changed block is encoded once*/
+	virtual bool update(PositionIntervalListPtr tids, const boost::any& new_value);
 	
+	/*! \brief removes the row from its block, a block below half of its capacity is merged with a neighbour*/
 	virtual bool remove(TID tid);
-	//assumes tid list is sorted ascending
+	/*! \brief removes the rows block by block, every changed block is encoded once, assumes tid list is sorted ascending*/
 	virtual bool remove(PositionListPtr tid);
+	/*! \brief removes the rows of all intervals block by block, every changed block is encoded once*/
+	virtual bool remove(PositionIntervalListPtr tids);
 	virtual bool clearContent();
 
 	virtual const boost::any get(TID tid);
@@ -61,25 +79,49 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 
+	/*! \brief decodes the rows [begin,begin+number_of_values) block by block, scans of the generic operators use it*/
+	virtual void getValues(TID begin, size_t number_of_values, T* values);
+
+	/***************** column algebra on the decoded values, the rows are encoded again afterwards *****************/
+	virtual bool add(const boost::any& new_Value);
+	virtual bool add(ColumnPtr column);
+	virtual bool minus(const boost::any& new_Value);
+	virtual bool minus(ColumnPtr column);
+	virtual bool multiply(const boost::any& new_Value);
+	virtual bool multiply(ColumnPtr column);
+	virtual bool division(const boost::any& new_Value);
+	virtual bool division(ColumnPtr column);
+
 
 	
 	virtual T& operator[](const int index);
-	std::vector<T>& getContent();
+	DeltaCodec<T>& getContent();
+	/*! \brief returns the encoding of the deltas, which load replaces by the encoding of the stored column*/
+	DeltaEncoding getEncoding() const throw();
 
 	private:
+	/*! \brief returns the codec for columns of type T with the encoding*/
+	DeltaCodec<T>* createCodec(DeltaEncoding encoding) const;
+	/*! \brief returns the values of all rows*/
+	void decodeAll(std::vector<T>& values) const;
+	/*! \brief replaces the content by the values*/
+	void encodeAll(const std::vector<T>& values);
+	/*! \brief replaces every row by operation(row,value)*/
+	template <typename Operation>
+	bool apply(const boost::any& new_value, Operation operation);
+	/*! \brief replaces every row by operation(row,row of column)*/
+	template <typename Operation>
+	bool apply(ColumnPtr column, Operation operation);
 
 		struct Type_TID_Comparator {
   			inline bool operator() (std::pair<T,TID> i, std::pair<T,TID> j) { return (i.first<j.first);}
 		} type_tid_comparator;
 
 
-	std::vector<T> values_;
-	 
-	 T t;
-	 T sum;
-	 T delt;
-	 T c;
-	 T org;
+	DeltaEncoding encoding_;
+	shared_pointer_namespace::shared_ptr<DeltaCodec<T> > codec_;
+	/*! value returned by operator[]*/
+	T key_;
 
 };
 
@@ -87,8 +129,39 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 
 	
 	template<class T>
-	DeltaCompressedColumn<T>::DeltaCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type), type_tid_comparator(), values_(), t(),sum(),delt(), c(), org(){
+	DeltaCompressedColumn<T>::DeltaCompressedColumn(const std::string& name, AttributeType db_type, DeltaEncoding encoding) : CompressedColumn<T>(name, db_type), type_tid_comparator(), encoding_(encoding), codec_(createCodec(encoding)), key_(){
+
+	}
+
+	template<class T>
+	DeltaCompressedColumn<T>::DeltaCompressedColumn(const DeltaCompressedColumn<T>& column) : CompressedColumn<T>(column), type_tid_comparator(), encoding_(column.encoding_), codec_(column.codec_->clone()), key_(){
+
+	}
+
+	template<class T>
+	DeltaEncoding DeltaCompressedColumn<T>::getEncoding() const throw(){
+		return encoding_;
+	}
+
+	template<class T>
+	DeltaCodec<T>* DeltaCompressedColumn<T>::createCodec(DeltaEncoding encoding) const{
+		if(encoding==VARIABLE_LENGTH_DELTAS){
+			std::cout << "Fatal Error!!! Variable length deltas are only supported for integer columns, column " << this->name_ << " stores fixed length deltas" << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+		}
+		return new BlockedDeltaCodec<T,PlainDeltaBlock<T> >();
+	}
 
+	template<>
+	inline DeltaCodec<int>* DeltaCompressedColumn<int>::createCodec(DeltaEncoding encoding) const{
+		if(encoding==VARIABLE_LENGTH_DELTAS) return new VarintDeltaCodec();
+		return new FrameOfReferenceDeltaCodec();
+	}
+
+	template<>
+	inline DeltaCodec<float>* DeltaCompressedColumn<float>::createCodec(DeltaEncoding) const{
+		//differences of floats are rounded, so float columns store the XOR of neighbouring values in every encoding
+		return new XorFloatCodec();
 	}
 
 	template<class T>
@@ -97,8 +170,8 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 	}
 
 	template<class T>
-	std::vector<T>& DeltaCompressedColumn<T>::getContent(){
-		return values_;
+	DeltaCodec<T>& DeltaCompressedColumn<T>::getContent(){
+		return *codec_;
 	}
 
 	template<class T>
@@ -106,89 +179,138 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 		if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
 			 T value = boost::any_cast<T>(new_value);
-			 values_.push_back(value);
-			 return true;
+			 return insert(value);
 		}
 		return false;
 	}
 
 	template<class T>
 	bool DeltaCompressedColumn<T>::insert(const T& new_value){
-      	
-      	T original = new_value;
-      	T change = new_value;
+		codec_->push_back(new_value);
+		return true;
+	}
 
-      	change -= t;
-      	t= original;
+	template<class T>
+	T& DeltaCompressedColumn<T>::operator[](const int index){
+		key_ = decompress(index);
+		return key_;
+	}
 
-        values_.push_back(change);
-        
-		return true;
+	template<class T>
+	T DeltaCompressedColumn<T>::decompress(const int index){
+		return codec_->get(size_t(index));
 	}
 
+	template<class T>
+	void DeltaCompressedColumn<T>::decodeAll(std::vector<T>& values) const{
+		values.resize(codec_->size());
+		if(!values.empty()) codec_->decode(0,values.size(),&values[0]);
+	}
 
- //    template<>
-	// bool DeltaCompressedColumn<std::string>::insert(const std::string& new_value){
+	template<class T>
+	void DeltaCompressedColumn<T>::encodeAll(const std::vector<T>& values){
+		codec_->clear();
+		for(size_t i=0;i<values.size();i++){
+			codec_->push_back(values[i]);
+		}
+	}
 
-            		
-	// return true;
-	// }
+	template<class T>
+	void DeltaCompressedColumn<T>::getValues(TID begin, size_t number_of_values, T* values){
+		codec_->decode(begin,number_of_values,values);
+	}
 
 	template<class T>
-	T& DeltaCompressedColumn<T>::operator[](const int index){
+	template <typename Operation>
+	bool DeltaCompressedColumn<T>::apply(const boost::any& new_value, Operation operation){
+		if(new_value.empty() || typeid(T)!=new_value.type()) return false;
+		T value = boost::any_cast<T>(new_value);
+		std::vector<T> values;
+		decodeAll(values);
+		for(size_t i=0;i<values.size();i++){
+			values[i]=operation(values[i],value);
+		}
+		encodeAll(values);
+		return true;
+	}
 
+	template<class T>
+	template <typename Operation>
+	bool DeltaCompressedColumn<T>::apply(ColumnPtr column_, Operation operation){
+		if(!column_ || column_->type()!=typeid(T) || column_->size()!=this->size()) return false;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(column_);
+		std::vector<T> values;
+		decodeAll(values);
+		for(typename ColumnBaseTyped<T>::Cursor cursor(*column);cursor.valid();cursor.next()){
+			values[cursor.getTID()]=operation(values[cursor.getTID()],cursor.value());
+		}
+		encodeAll(values);
+		return true;
+	}
 
-		  delt = decompress(index);
-		 return delt;
+	template<class T>
+	bool DeltaCompressedColumn<T>::add(const boost::any& new_value){
+		return apply(new_value,std::plus<T>());
 	}
 
+	template<class T>
+	bool DeltaCompressedColumn<T>::add(ColumnPtr column){
+		return apply(column,std::plus<T>());
+	}
 
 	template<class T>
-	T DeltaCompressedColumn<T>::decompress(const int index){
+	bool DeltaCompressedColumn<T>::minus(const boost::any& new_value){
+		return apply(new_value,std::minus<T>());
+	}
 
-	  sum = 0;
-		for(int i=0;i<=index;i++){
-			sum+= values_[i] ;
-		}
+	template<class T>
+	bool DeltaCompressedColumn<T>::minus(ColumnPtr column){
+		return apply(column,std::minus<T>());
+	}
 
-	 	return sum;
+	template<class T>
+	bool DeltaCompressedColumn<T>::multiply(const boost::any& new_value){
+		return apply(new_value,std::multiplies<T>());
 	}
 
+	template<class T>
+	bool DeltaCompressedColumn<T>::multiply(ColumnPtr column){
+		return apply(column,std::multiplies<T>());
+	}
+
+	template<class T>
+	bool DeltaCompressedColumn<T>::division(const boost::any& new_value){
+		//check that we do not devide by zero
+		if(new_value.empty() || typeid(T)!=new_value.type() || boost::any_cast<T>(new_value)==T()) return false;
+		return apply(new_value,std::divides<T>());
+	}
+
+	template<class T>
+	bool DeltaCompressedColumn<T>::division(ColumnPtr column){
+		return apply(column,std::divides<T>());
+	}
 
 	template<class T>
 	bool DeltaCompressedColumn<T>::update(TID tid, const boost::any& new_value ){
-	    typename std::vector<T>::size_type sz = values_.size();	
- 		
- 		sum = 0;
-
-		for (unsigned i=0;i<sz;i++) {
-			values_[i] += sum;
-			sum = values_[i];
-		 }
-		
-		T value = boost::any_cast<T>(new_value);
-		  values_[tid] = value;
-
-		c = 0;
-		for (unsigned i=0;i<sz;i++) {
-			org = values_[i];
-			values_[i] -= c;
-			c = org;
-		}		
+		if(new_value.empty() || typeid(T)!=new_value.type()) return false;
+		if(tid>=codec_->size()) return false;
+		codec_->update(tid,boost::any_cast<T>(new_value));
 		return true;
 	}
 
 	template <typename T> 
 	template <typename InputIterator>
 	bool DeltaCompressedColumn<T>::insert(InputIterator first , InputIterator last){
-		this->values_.insert(this->values_.end(),first,last);
+		for(;first!=last;++first){
+			insert(*first);
+		}
 		return true;
 	}
 
 	template<class T>
 	const boost::any DeltaCompressedColumn<T>::get(TID tid){
-				if(tid<values_.size())
- 			return boost::any(values_[tid]);
+				if(tid<codec_->size())
+ 			return boost::any(decompress(tid));
 		else{
 			std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid  << std::endl;
 		}
@@ -200,13 +322,15 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 	void DeltaCompressedColumn<T>::print() const throw(){
 		std::cout << "| " << this->name_ << " |" << std::endl;
 		std::cout << "________________________" << std::endl;
-		for(unsigned int i=0;i<values_.size();i++){
-			std::cout << "| " << values_[i] << " |" << std::endl;
+		std::vector<T> values;
+		decodeAll(values);
+		for(unsigned int i=0;i<values.size();i++){
+			std::cout << "| " << values[i] << " |" << std::endl;
 		}
 	}
 	template<class T>
 	size_t DeltaCompressedColumn<T>::size() const throw(){
-		return values_.size();
+		return codec_->size();
 	}
 
 	template<class T>
@@ -225,7 +349,7 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 			 T value = boost::any_cast<T>(new_value);
 			 for(unsigned int i=0;i<tids->size();i++){
 				TID tid=(*tids)[i];
-				values_[tid]=value;
+				if(tid<codec_->size()) codec_->update(tid,value);
 			}
 			return true;
 		}else{
@@ -235,25 +359,28 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 	}
 	
 	template<class T>
-	bool DeltaCompressedColumn<T>::remove(TID tid){
-	
-	typename std::vector<T>::size_type sz = values_.size();
-		sum = 0;
-
-		for (unsigned i=0;i<sz;i++) {
-			values_[i] += sum;
-			sum = values_[i];
+	bool DeltaCompressedColumn<T>::update(PositionIntervalListPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		if(new_value.empty()) return false;
+		if(typeid(T)!=new_value.type()){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			return false;
 		}
-		
-        values_.erase(values_.begin()+tid);
-
-		c = 0;
-		for (unsigned i=0;i<sz;i++) {
-			org = values_[i];
-			values_[i] -= c;
-			c = org;
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(!tids->empty() && tids->rbegin()->second>codec_->size()) return false;
+		PositionList positions;
+		positions.reserve(tids->size());
+		for(PositionIntervalList::Cursor cursor(*tids);cursor.valid();cursor.next()){
+			positions.push_back(cursor.getTID());
 		}
+		codec_->update(positions,boost::any_cast<T>(new_value));
+		return true;
+	}
 
+	template<class T>
+	bool DeltaCompressedColumn<T>::remove(TID tid){
+		if(tid>=codec_->size()) return false;
+		codec_->erase(tid);
 		return true;	
 	}
 	
@@ -266,16 +393,28 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 		if(tids->empty())
 			return false;		
 
-		typename PositionList::reverse_iterator rit;
-
-		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit)
-			values_.erase(values_.begin()+(*rit));
+		codec_->erase(*tids);
 		return true;			
 	}
 
+	template<class T>
+	bool DeltaCompressedColumn<T>::remove(PositionIntervalListPtr tids){
+		if(!tids) return false;
+		if(tids->empty()) return false;
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(tids->rbegin()->second>codec_->size()) return false;
+		PositionList positions;
+		positions.reserve(tids->size());
+		for(PositionIntervalList::Cursor cursor(*tids);cursor.valid();cursor.next()){
+			positions.push_back(cursor.getTID());
+		}
+		codec_->erase(positions);
+		return true;
+	}
+
 	template<class T>
 	bool DeltaCompressedColumn<T>::clearContent(){
-		values_.clear();
+		codec_->clear();
 		return true;
 	}
 
@@ -288,7 +427,9 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 		std::ofstream outfile (path.c_str(),std::ios_base::binary | std::ios_base::out);
 		boost::archive::binary_oarchive oa(outfile);
 
-		oa << values_;
+		const int encoding = encoding_;
+		oa << encoding;
+		codec_->save(oa);
 
 		outfile.flush();
 		outfile.close();
@@ -304,7 +445,14 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 		//std::cout << "Opening File '" << path << "'..." << std::endl;
 		std::ifstream infile (path.c_str(),std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ia(infile);
-		ia >> values_;
+		//the stored column may use another encoding than this column
+		int encoding;
+		ia >> encoding;
+		if(encoding!=encoding_){
+			encoding_=DeltaEncoding(encoding);
+			codec_.reset(createCodec(encoding_));
+		}
+		codec_->load(ia);
 		infile.close();
 		return true;
 	}
@@ -313,16 +461,7 @@ class DeltaCompressedColumn : public CompressedColumn<T>{
 
 	template<class T>
 	unsigned int DeltaCompressedColumn<T>::getSizeinBytes() const throw(){
-		return values_.capacity()*sizeof(T);
-	}
-
-	template<>
-	inline unsigned int DeltaCompressedColumn<std::string>::getSizeinBytes() const throw(){
-		unsigned int size_in_bytes=0;
-		for(unsigned int i=0;i<values_.size();++i){
-			size_in_bytes+=values_[i].capacity();
-		}
-		return size_in_bytes;
+		return codec_->getSizeinBytes();
 	}
 
 /***************** End of Implementation Section ******************/
@@ -0,0 +1,538 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <core/global_definitions.hpp>
+
+namespace CoGaDB{
+
+/*! \brief the representation of the deltas of a DeltaCompressedColumn, columns of type int support variable length deltas*/
+enum DeltaEncoding{FIXED_LENGTH_DELTAS,VARIABLE_LENGTH_DELTAS};
+
+/*!
+ *  \brief     This class is the interface of the codecs, which store the rows of a DeltaCompressedColumn.
+ *  \details   A codec appends rows, decodes single rows and ranges of rows, replaces and erases rows and stores its content in an archive.
+ */
+template<class T>
+class DeltaCodec{
+	public:
+	virtual ~DeltaCodec();
+	/*! \brief returns a deep copy of the codec*/
+	virtual DeltaCodec<T>* clone() const=0;
+	/*! \brief returns the number of rows*/
+	virtual size_t size() const throw()=0;
+	/*! \brief appends value behind the last row*/
+	virtual void push_back(const T& value)=0;
+	/*! \brief returns the value of the row on position index*/
+	virtual T get(size_t index) const=0;
+	/*! \brief writes the values of the rows [begin,begin+number_of_values) to values*/
+	virtual void decode(size_t begin, size_t number_of_values, T* values) const=0;
+	/*! \brief replaces the value of the row on position index*/
+	virtual void update(size_t index, const T& value)=0;
+	/*! \brief replaces the values of the rows on the positions, which are sorted ascending, positions behind the last row are ignored*/
+	virtual void update(const std::vector<TID>& positions, const T& value)=0;
+	/*! \brief removes the row on position index*/
+	virtual void erase(size_t index)=0;
+	/*! \brief removes the rows on the positions, which are sorted ascending, positions behind the last row are ignored*/
+	virtual void erase(const std::vector<TID>& positions)=0;
+	virtual void clear()=0;
+	/*! \brief returns the size in bytes the codec consumes in main memory*/
+	virtual size_t getSizeinBytes() const throw()=0;
+	virtual void save(boost::archive::binary_oarchive& archive) const=0;
+	virtual void load(boost::archive::binary_iarchive& archive)=0;
+};
+
+/*!
+ *  \brief     This class is a Fenwick tree over the number of rows of a sequence of blocks.
+ *  \details   Counted from one, entry i holds the number of rows of the blocks (i-l,i], where l is the lowest set bit of i. So the block of a
+ *             row is found and the number of rows of a block is changed in O(log blocks), without touching the entries of all following blocks.
+ */
+class BlockIndex{
+	public:
+	/***************** constructors and destructor *****************/
+	BlockIndex();
+
+	/*! \brief returns the number of blocks*/
+	size_t size() const throw();
+	/*! \brief appends a block with number_of_rows rows*/
+	void push_back(size_t number_of_rows);
+	/*! \brief changes the number of rows of block from old_number_of_rows to new_number_of_rows*/
+	void resize(size_t block, size_t old_number_of_rows, size_t new_number_of_rows);
+	/*! \brief returns the block of the row on position index and the position of the first row of the block, index has to be smaller than the number of rows of all blocks*/
+	size_t find(size_t index, size_t& block_begin) const;
+	void clear();
+	size_t getSizeinBytes() const throw();
+
+	private:
+	std::vector<boost::uint64_t> sums_;
+};
+
+/*!
+ *  \brief     This codec stores the rows in blocks of at most block_size rows, which are encoded by Block independently of each other.
+ *  \details   Every block owns its memory, so a block is encoded again without moving the other blocks. A BlockIndex finds the block of a row,
+ *             while all blocks are full the block follows from the position directly. New rows are kept unencoded in a tail, which becomes a
+ *             new block when it holds block_size rows. A block, which falls below half of block_size rows, is merged with a neighbour or, if
+ *             both do not fit into one block, the rows of both are split evenly between them. So every block except the last one holds at least
+ *             half of block_size rows. Only a merge removes a block from the sequence, which moves the following blocks and rebuilds the index.
+ *
+ *             A Block provides block_size, size(), encode(values,number_of_values), get(index), decode(values) into a buffer of block_size
+ *             values, getSizeinBytes() of the memory it allocates, swap(block) and serialize(archive,version).
+ */
+template<class T, class Block>
+class BlockedDeltaCodec : public DeltaCodec<T>{
+	public:
+	/*! \brief maximal number of rows per block*/
+	static const size_t block_size=Block::block_size;
+	/***************** constructors and destructor *****************/
+	BlockedDeltaCodec();
+
+	virtual DeltaCodec<T>* clone() const;
+	virtual size_t size() const throw();
+	virtual void push_back(const T& value);
+	virtual T get(size_t index) const;
+	virtual void decode(size_t begin, size_t number_of_values, T* values) const;
+	/*! \brief encodes the block of the row again*/
+	virtual void update(size_t index, const T& value);
+	/*! \brief replaces the rows block by block, every changed block is encoded once*/
+	virtual void update(const std::vector<TID>& positions, const T& value);
+	/*! \brief encodes the block of the row again and merges or balances it with a neighbour, if it falls below half of block_size rows*/
+	virtual void erase(size_t index);
+	/*! \brief removes the rows block by block from the back, every changed block is encoded once*/
+	virtual void erase(const std::vector<TID>& positions);
+	virtual void clear();
+	virtual size_t getSizeinBytes() const throw();
+	virtual void save(boost::archive::binary_oarchive& archive) const;
+	virtual void load(boost::archive::binary_iarchive& archive);
+
+	private:
+	/*! \brief returns the block of the row on position index, which is in front of the tail, and the position of the first row of the block*/
+	size_t findBlock(size_t index, size_t& block_begin) const;
+	/*! \brief encodes the number_of_values values into block and updates the index*/
+	void writeBlock(size_t block, const T* values, size_t number_of_values);
+	/*! \brief merges the rows of right into left or splits the rows of both evenly between them, returns true if right is empty afterwards*/
+	static bool balance(Block& left, Block& right);
+	/*! \brief balances the blocks below half of block_size rows with their neighbours in one pass, removes empty blocks and rebuilds the index*/
+	void balanceAll();
+	void rebuildIndex();
+
+	std::vector<Block> blocks_;
+	/*! number of rows of every block*/
+	BlockIndex index_;
+	/*! number of rows in the blocks*/
+	boost::uint64_t encoded_rows_;
+	/*! rows behind the last block, which are encoded when there are block_size of them*/
+	std::vector<T> tail_;
+};
+
+/*!
+ *  \brief     This block stores the value of its first row and the difference of every further row to its predecessor as values of type T.
+ */
+template<class T>
+class PlainDeltaBlock{
+	public:
+	/*! \brief maximal number of rows per block*/
+	static const size_t block_size=128;
+	/***************** constructors and destructor *****************/
+	PlainDeltaBlock();
+
+	size_t size() const throw();
+	void encode(const T* values, size_t number_of_values);
+	T get(size_t index) const;
+	void decode(T* values) const;
+	size_t getSizeinBytes() const throw();
+	void swap(PlainDeltaBlock<T>& block);
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & deltas_;
+	}
+
+	/*! value of the first row and difference of every further row to its predecessor*/
+	std::vector<T> deltas_;
+};
+
+/*! \brief removes the values on the positions [first,last) minus offset from the number_of_values values in one pass, returns the number of remaining values
+ *  \details the positions are sorted ascending, a position, which occurs several times, removes one value*/
+template<class T, class Iterator>
+size_t erase_positions(T* values, size_t number_of_values, Iterator first, Iterator last, size_t offset){
+	if(first==last) return number_of_values;
+	size_t kept = size_t(*first)-offset;
+	for(size_t i=kept;i<number_of_values;i++){
+		if(first!=last && size_t(*first)-offset==i){
+			while(first!=last && size_t(*first)-offset==i) ++first;
+		}else{
+			values[kept++]=values[i];
+		}
+	}
+	return kept;
+}
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	DeltaCodec<T>::~DeltaCodec(){
+
+	}
+
+	inline BlockIndex::BlockIndex() : sums_(){
+
+	}
+
+	inline size_t BlockIndex::size() const throw(){
+		return sums_.size();
+	}
+
+	inline void BlockIndex::push_back(size_t number_of_rows){
+		//the entries in front of the new entry up to its lowest set bit hold the rows of the blocks it covers
+		const size_t entry = sums_.size()+1;
+		boost::uint64_t sum = number_of_rows;
+		for(size_t child=1;child<(entry & (~entry+1));child<<=1){
+			sum += sums_[entry-child-1];
+		}
+		sums_.push_back(sum);
+	}
+
+	inline void BlockIndex::resize(size_t block, size_t old_number_of_rows, size_t new_number_of_rows){
+		//computed modulo 2^64, so a shrinking block subtracts its removed rows
+		const boost::uint64_t change = boost::uint64_t(new_number_of_rows)-boost::uint64_t(old_number_of_rows);
+		for(size_t entry=block+1;entry<=sums_.size();entry+=entry & (~entry+1)){
+			sums_[entry-1] += change;
+		}
+	}
+
+	inline size_t BlockIndex::find(size_t index, size_t& block_begin) const{
+		size_t step = 1;
+		while(step*2<=sums_.size()) step*=2;
+		//the number of blocks in front of the block of the row, which start not behind the row
+		size_t entry = 0;
+		boost::uint64_t remaining = index;
+		for(;step>0;step>>=1){
+			if(entry+step<=sums_.size() && sums_[entry+step-1]<=remaining){
+				entry += step;
+				remaining -= sums_[entry-1];
+			}
+		}
+		block_begin = index-size_t(remaining);
+		return entry;
+	}
+
+	inline void BlockIndex::clear(){
+		sums_.clear();
+	}
+
+	inline size_t BlockIndex::getSizeinBytes() const throw(){
+		return sums_.capacity()*sizeof(boost::uint64_t);
+	}
+
+	template<class T, class Block>
+	const size_t BlockedDeltaCodec<T,Block>::block_size;
+
+	template<class T, class Block>
+	BlockedDeltaCodec<T,Block>::BlockedDeltaCodec() : DeltaCodec<T>(), blocks_(), index_(), encoded_rows_(0), tail_(){
+
+	}
+
+	template<class T, class Block>
+	DeltaCodec<T>* BlockedDeltaCodec<T,Block>::clone() const{
+		return new BlockedDeltaCodec<T,Block>(*this);
+	}
+
+	template<class T, class Block>
+	size_t BlockedDeltaCodec<T,Block>::size() const throw(){
+		return size_t(encoded_rows_)+tail_.size();
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::push_back(const T& value){
+		tail_.push_back(value);
+		if(tail_.size()==block_size){
+			blocks_.push_back(Block());
+			blocks_.back().encode(&tail_[0],tail_.size());
+			index_.push_back(tail_.size());
+			encoded_rows_+=tail_.size();
+			tail_.clear();
+		}
+	}
+
+	template<class T, class Block>
+	T BlockedDeltaCodec<T,Block>::get(size_t index) const{
+		if(index>=encoded_rows_){
+			return tail_[index-size_t(encoded_rows_)];
+		}
+		size_t block_begin;
+		const size_t block = findBlock(index,block_begin);
+		return blocks_[block].get(index-block_begin);
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::decode(size_t begin, size_t number_of_values, T* values) const{
+		const size_t end = begin+number_of_values;
+		if(begin<end && begin<encoded_rows_){
+			T block_values[block_size];
+			size_t block_begin;
+			size_t block = findBlock(begin,block_begin);
+			while(begin<end && begin<encoded_rows_){
+				const size_t block_end = block_begin+blocks_[block].size();
+				const size_t range_end = std::min(end,block_end);
+				if(begin==block_begin && range_end==block_end && end-begin>=block_size){
+					//a block with less than block_size rows writes behind its rows, which the following blocks overwrite
+					blocks_[block].decode(values);
+				}else{
+					blocks_[block].decode(block_values);
+					std::copy(block_values+(begin-block_begin),block_values+(range_end-block_begin),values);
+				}
+				values+=range_end-begin;
+				begin=range_end;
+				block_begin=block_end;
+				block++;
+			}
+		}
+		if(begin<end){
+			std::copy(tail_.begin()+(begin-size_t(encoded_rows_)),tail_.begin()+(end-size_t(encoded_rows_)),values);
+		}
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::update(size_t index, const T& value){
+		if(index>=encoded_rows_){
+			tail_[index-size_t(encoded_rows_)]=value;
+			return;
+		}
+		size_t block_begin;
+		const size_t block = findBlock(index,block_begin);
+		T values[block_size];
+		blocks_[block].decode(values);
+		values[index-block_begin]=value;
+		blocks_[block].encode(values,blocks_[block].size());
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::update(const std::vector<TID>& positions, const T& value){
+		std::vector<TID>::const_iterator it = positions.begin();
+		const std::vector<TID>::const_iterator end = std::lower_bound(positions.begin(),positions.end(),size());
+		T values[block_size];
+		while(it!=end && *it<encoded_rows_){
+			size_t block_begin;
+			const size_t block = findBlock(*it,block_begin);
+			const size_t block_end = block_begin+blocks_[block].size();
+			blocks_[block].decode(values);
+			for(;it!=end && *it<block_end;++it){
+				values[*it-block_begin]=value;
+			}
+			blocks_[block].encode(values,blocks_[block].size());
+		}
+		for(;it!=end;++it){
+			tail_[*it-size_t(encoded_rows_)]=value;
+		}
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::erase(size_t index){
+		if(index>=encoded_rows_){
+			tail_.erase(tail_.begin()+(index-size_t(encoded_rows_)));
+			return;
+		}
+		size_t block_begin;
+		const size_t block = findBlock(index,block_begin);
+		T values[block_size];
+		const size_t number_of_values = blocks_[block].size();
+		blocks_[block].decode(values);
+		std::copy(values+(index-block_begin)+1,values+number_of_values,values+(index-block_begin));
+		writeBlock(block,values,number_of_values-1);
+		if(number_of_values-1>=block_size/2) return;
+		if(blocks_.size()==1){
+			if(number_of_values==1){
+				blocks_.clear();
+				index_.clear();
+			}
+			return;
+		}
+		//the last block is balanced with its predecessor, every other block with its successor
+		const size_t left = block+1<blocks_.size() ? block : block-1;
+		const size_t left_rows = blocks_[left].size();
+		const size_t right_rows = blocks_[left+1].size();
+		if(balance(blocks_[left],blocks_[left+1])){
+			//the following blocks move to the front, their rows stay where they are
+			for(size_t i=left+1;i+1<blocks_.size();i++){
+				blocks_[i].swap(blocks_[i+1]);
+			}
+			blocks_.pop_back();
+			rebuildIndex();
+		}else{
+			index_.resize(left,left_rows,blocks_[left].size());
+			index_.resize(left+1,right_rows,blocks_[left+1].size());
+		}
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::erase(const std::vector<TID>& positions){
+		//rows are removed from the back, so the positions of the rows in front of a changed block stay valid
+		std::vector<TID>::const_iterator end = std::lower_bound(positions.begin(),positions.end(),size());
+		std::vector<TID>::const_iterator begin = std::lower_bound(positions.begin(),end,size_t(encoded_rows_));
+		if(begin!=end){
+			tail_.resize(erase_positions(&tail_[0],tail_.size(),begin,end,size_t(encoded_rows_)));
+		}
+		bool underfull = false;
+		T values[block_size];
+		while(begin!=positions.begin()){
+			size_t block_begin;
+			const size_t block = findBlock(*(begin-1),block_begin);
+			end = begin;
+			begin = std::lower_bound(positions.begin(),end,block_begin);
+			blocks_[block].decode(values);
+			const size_t number_of_values = erase_positions(values,blocks_[block].size(),begin,end,block_begin);
+			writeBlock(block,values,number_of_values);
+			if(number_of_values<block_size/2) underfull=true;
+		}
+		if(underfull) balanceAll();
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::clear(){
+		blocks_.clear();
+		index_.clear();
+		encoded_rows_=0;
+		tail_.clear();
+	}
+
+	template<class T, class Block>
+	size_t BlockedDeltaCodec<T,Block>::getSizeinBytes() const throw(){
+		size_t size_in_bytes = blocks_.capacity()*sizeof(Block)+index_.getSizeinBytes()+tail_.capacity()*sizeof(T);
+		for(size_t i=0;i<blocks_.size();i++){
+			size_in_bytes += blocks_[i].getSizeinBytes();
+		}
+		return size_in_bytes;
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::save(boost::archive::binary_oarchive& archive) const{
+		archive << blocks_;
+		archive << tail_;
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::load(boost::archive::binary_iarchive& archive){
+		archive >> blocks_;
+		archive >> tail_;
+		rebuildIndex();
+	}
+
+	template<class T, class Block>
+	size_t BlockedDeltaCodec<T,Block>::findBlock(size_t index, size_t& block_begin) const{
+		if(encoded_rows_==blocks_.size()*block_size){
+			block_begin = index-index%block_size;
+			return index/block_size;
+		}
+		return index_.find(index,block_begin);
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::writeBlock(size_t block, const T* values, size_t number_of_values){
+		const size_t old_number_of_values = blocks_[block].size();
+		blocks_[block].encode(values,number_of_values);
+		index_.resize(block,old_number_of_values,number_of_values);
+		encoded_rows_ = encoded_rows_-old_number_of_values+number_of_values;
+	}
+
+	template<class T, class Block>
+	bool BlockedDeltaCodec<T,Block>::balance(Block& left, Block& right){
+		T values[2*block_size];
+		const size_t left_rows = left.size();
+		const size_t number_of_values = left_rows+right.size();
+		left.decode(values);
+		right.decode(values+left_rows);
+		if(number_of_values<=block_size){
+			left.encode(values,number_of_values);
+			right.encode(values,0);
+			return true;
+		}
+		left.encode(values,number_of_values/2);
+		right.encode(values+number_of_values/2,number_of_values-number_of_values/2);
+		return false;
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::balanceAll(){
+		size_t kept = 0;
+		for(size_t i=0;i<blocks_.size();i++){
+			if(blocks_[i].size()==0) continue;
+			if(kept>0 && (blocks_[kept-1].size()<block_size/2 || blocks_[i].size()<block_size/2) && balance(blocks_[kept-1],blocks_[i])) continue;
+			if(kept!=i) blocks_[kept].swap(blocks_[i]);
+			kept++;
+		}
+		blocks_.resize(kept);
+		rebuildIndex();
+	}
+
+	template<class T, class Block>
+	void BlockedDeltaCodec<T,Block>::rebuildIndex(){
+		index_.clear();
+		encoded_rows_=0;
+		for(size_t i=0;i<blocks_.size();i++){
+			index_.push_back(blocks_[i].size());
+			encoded_rows_+=blocks_[i].size();
+		}
+	}
+
+	template<class T>
+	const size_t PlainDeltaBlock<T>::block_size;
+
+	template<class T>
+	PlainDeltaBlock<T>::PlainDeltaBlock() : deltas_(){
+
+	}
+
+	template<class T>
+	size_t PlainDeltaBlock<T>::size() const throw(){
+		return deltas_.size();
+	}
+
+	template<class T>
+	void PlainDeltaBlock<T>::encode(const T* values, size_t number_of_values){
+		std::vector<T> deltas(values,values+number_of_values);
+		for(size_t i=1;i<number_of_values;i++){
+			deltas[i] -= values[i-1];
+		}
+		deltas_.swap(deltas);
+	}
+
+	template<class T>
+	T PlainDeltaBlock<T>::get(size_t index) const{
+		T value = deltas_[0];
+		for(size_t i=1;i<=index;i++){
+			value+=deltas_[i];
+		}
+		return value;
+	}
+
+	template<class T>
+	void PlainDeltaBlock<T>::decode(T* values) const{
+		if(deltas_.empty()) return;
+		values[0]=deltas_[0];
+		for(size_t i=1;i<deltas_.size();i++){
+			values[i] = values[i-1]+deltas_[i];
+		}
+	}
+
+	template<class T>
+	size_t PlainDeltaBlock<T>::getSizeinBytes() const throw(){
+		return deltas_.capacity()*sizeof(T);
+	}
+
+	template<class T>
+	void PlainDeltaBlock<T>::swap(PlainDeltaBlock<T>& block){
+		deltas_.swap(block.deltas_);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
@@ -0,0 +1,722 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <core/global_definitions.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This class stores the distinct values of a Dictionary, the position of a value is its code.
+ *  \details   The generic version keeps the values in an array, there is a specialization for strings, which packs them into one contiguous heap.
+ */
+template<class T>
+class DictionaryValues{
+	public:
+	typedef unsigned int Code;
+	DictionaryValues();
+
+	void push_back(const T& value);
+	/*! \brief replaces the value of code*/
+	void set(Code code, const T& value);
+	inline void get(Code code, T& value) const;
+	inline bool equals(Code code, const T& value) const;
+	inline bool less(Code code, const T& value) const;
+	inline bool less(const T& value, Code code) const;
+	inline bool less(Code code1, Code code2) const;
+	inline std::size_t hash(Code code) const;
+	size_t size() const throw();
+	/*! \brief reorders the values, so that the value with code order[i] gets code i, codes missing in order are dropped*/
+	void permute(const std::vector<Code>& order);
+	unsigned int getSizeinBytes() const throw();
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & values_;
+	}
+
+	std::vector<T> values_;
+};
+
+/*!
+ *  \brief     The values of a string dictionary are stored in one character heap, per code an offset and a length mark where its value is.
+ *  \details   This avoids one heap allocation per distinct value and keeps the dictionary in flat buffers. Replacing a value never moves the
+ *             characters of other values: a value that does not fit into the old one is appended and leaves dead characters behind, which are
+ *             reclaimed once they make up half of the heap and by permute. A sorted dictionary is front coded when it is stored.
+ */
+template<>
+class DictionaryValues<std::string>{
+	public:
+	typedef unsigned int Code;
+	typedef boost::uint64_t Offset;
+	typedef boost::uint32_t Length;
+	DictionaryValues();
+
+	void push_back(const std::string& value);
+	/*! \brief replaces the value of code in amortized O(length of value), the other values stay in place*/
+	void set(Code code, const std::string& value);
+	inline void get(Code code, std::string& value) const;
+	inline bool equals(Code code, const std::string& value) const;
+	inline bool less(Code code, const std::string& value) const;
+	inline bool less(const std::string& value, Code code) const;
+	inline bool less(Code code1, Code code2) const;
+	inline std::size_t hash(Code code) const;
+	size_t size() const throw();
+	void permute(const std::vector<Code>& order);
+	unsigned int getSizeinBytes() const throw();
+
+	private:
+	inline const char* data(Code code) const;
+	inline size_t length(Code code) const;
+	/*! \brief copies the values of the codes in order back to back into a new heap, which drops the dead characters*/
+	void pack(const std::vector<Code>& order);
+	/*! \brief lexicographical comparison of two character sequences, the same order as std::string uses*/
+	static inline int compare(const char* str1, size_t length1, const char* str2, size_t length2);
+
+	friend class boost::serialization::access;
+	/*! a sorted dictionary is written front coded: per value the length of the prefix it shares with its predecessor and the remaining suffix*/
+	template<class Archive>
+	void save(Archive& ar, const unsigned int) const{
+		bool sorted=true;
+		for(Code code=1;code<size() && sorted;++code){
+			sorted = less(code-1,code);
+		}
+		ar & sorted;
+		if(!sorted){
+			//the values are written back to back, so the file contains no dead characters
+			std::vector<Offset> offsets(1,0);
+			std::vector<char> heap;
+			heap.reserve(heap_.size()-dead_bytes_);
+			for(Code code=0;code<size();++code){
+				heap.insert(heap.end(),data(code),data(code)+length(code));
+				offsets.push_back(heap.size());
+			}
+			ar & offsets;
+			ar & heap;
+			return;
+		}
+		std::vector<boost::uint32_t> prefix_lengths(size());
+		std::vector<Offset> suffix_offsets(1,0);
+		std::vector<char> suffixes;
+		for(Code code=0;code<size();++code){
+			size_t prefix_length=0;
+			if(code>0){
+				size_t max_length = std::min(length(code-1),length(code));
+				while(prefix_length<max_length && data(code-1)[prefix_length]==data(code)[prefix_length]){
+					++prefix_length;
+				}
+			}
+			prefix_lengths[code]=boost::uint32_t(prefix_length);
+			suffixes.insert(suffixes.end(),data(code)+prefix_length,data(code)+length(code));
+			suffix_offsets.push_back(suffixes.size());
+		}
+		ar & prefix_lengths;
+		ar & suffix_offsets;
+		ar & suffixes;
+	}
+	template<class Archive>
+	void load(Archive& ar, const unsigned int){
+		bool sorted;
+		ar & sorted;
+		begins_.clear();
+		lengths_.clear();
+		dead_bytes_=0;
+		if(!sorted){
+			std::vector<Offset> offsets;
+			ar & offsets;
+			ar & heap_;
+			for(Code code=0;code+1<offsets.size();++code){
+				begins_.push_back(offsets[code]);
+				lengths_.push_back(Length(offsets[code+1]-offsets[code]));
+			}
+			return;
+		}
+		std::vector<boost::uint32_t> prefix_lengths;
+		std::vector<Offset> suffix_offsets;
+		std::vector<char> suffixes;
+		ar & prefix_lengths;
+		ar & suffix_offsets;
+		ar & suffixes;
+		heap_.clear();
+		for(Code code=0;code<prefix_lengths.size();++code){
+			begins_.push_back(heap_.size());
+			//the shared prefix is copied from the start of the predecessor
+			for(size_t i=0;i<prefix_lengths[code];++i){
+				heap_.push_back(heap_[begins_[code-1]+i]);
+			}
+			heap_.insert(heap_.end(),suffixes.begin()+suffix_offsets[code],suffixes.begin()+suffix_offsets[code+1]);
+			lengths_.push_back(Length(heap_.size()-begins_[code]));
+		}
+	}
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+	/*! characters of all values, including the dead characters of replaced values*/
+	std::vector<char> heap_;
+	/*! value i occupies heap_[begins_[i]] to heap_[begins_[i]+lengths_[i]-1]*/
+	std::vector<Offset> begins_;
+	std::vector<Length> lengths_;
+	/*! number of characters in heap_ that belong to no value*/
+	Offset dead_bytes_;
+};
+
+/*!
+ *  \brief     This class maps the distinct values of one or more dictionary compressed columns to dense integer codes and back.
+ *  \details   The code of a value is its position in the value array, so decoding is a single array access. Encoding uses an open addressing
+ *             hash table, which stores codes only and compares against the value array, so every value is kept once. Several columns
+ *             may share a dictionary by reference, then equal values have equal codes in all of them.
+ */
+template<class T>
+class Dictionary{
+	public:
+	typedef unsigned int Code;
+	/***************** constructors and destructor *****************/
+	Dictionary();
+
+	/*! \brief returns the code of value, adds value to the dictionary if it is not yet contained*/
+	Code encode(const T& value);
+	/*! \brief looks up the code of value without changing the dictionary
+	 *  \return false, if value is not contained in the dictionary*/
+	bool find(const T& value, Code& code) const;
+	/*! \brief returns the value of code*/
+	inline T decode(Code code) const;
+	/*! \brief writes the value of code to value, which allows to reuse the memory of value*/
+	inline void decode(Code code, T& value) const;
+	/*! \brief compares the value of code with value without decoding it*/
+	inline bool less(Code code, const T& value) const;
+	/*! \brief compares value with the value of code without decoding it*/
+	inline bool less(const T& value, Code code) const;
+	/*! \brief returns the number of codes, including the free ones*/
+	size_t size() const throw();
+
+	/*! \brief adds number_of_rows rows that store code*/
+	inline void addReference(Code code, unsigned int number_of_rows=1);
+	/*! \brief removes a row that stores code, a code that no row stores anymore is freed and reused for the next new value*/
+	inline void removeReference(Code code);
+	/*! \brief sets the number of rows of all codes to zero, used to count the rows again*/
+	void resetReferences();
+	/*! \brief frees all codes that no row stores*/
+	void releaseUnusedCodes();
+	/*! \brief returns the number of codes that no row stores and that wait for reuse*/
+	size_t getNumberOfFreeCodes() const throw();
+	/*! \brief drops the free codes and renumbers the others densely, keeping their order
+	 *  \details new_codes maps every old code to its new code, the caller has to renumber the codes it stores*/
+	void compact(std::vector<Code>& new_codes);
+
+	/*! \brief returns true, if the order of the codes matches the order of the values*/
+	bool isOrderPreserving() const throw();
+	/*! \brief sorts the values and renumbers the codes, so that the code order matches the value order
+	 *  \details new_codes maps every old code to its new code, the caller has to renumber the codes it stores*/
+	void makeOrderPreserving(std::vector<Code>& new_codes);
+	/*! \brief writes the position of every code in the value order to ranks, which is the identity for an order preserving dictionary*/
+	void getRanks(std::vector<Code>& ranks) const;
+	/*! \brief returns the first code whose value is not less than value, requires an order preserving dictionary*/
+	Code lowerBound(const T& value) const;
+	/*! \brief returns the first code whose value is greater than value, requires an order preserving dictionary*/
+	Code upperBound(const T& value) const;
+
+	/*! \brief returns the size in bytes the dictionary consumes in main memory*/
+	unsigned int getSizeinBytes() const throw();
+
+	private:
+	friend class boost::serialization::access;
+	/*! only the values are stored, the hash table is rebuilt when loading*/
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & values_;
+		if(Archive::is_loading::value){
+			rebuild();
+		}
+	}
+	void rebuild();
+	/*! \brief returns the slot of value in the hash table, which is either empty or contains the code of value*/
+	inline size_t findSlot(const T& value) const;
+	/*! \brief rebuilds the hash table with number_of_slots slots, which has to be a power of two*/
+	void rehash(size_t number_of_slots);
+	/*! \brief removes code from the hash table and marks it as free*/
+	void release(Code code);
+
+	/*! marks an unused slot in the hash table*/
+	static const Code empty_slot = ~Code(0);
+	/*! maps a code to its value, used for decoding*/
+	DictionaryValues<T> values_;
+	/*! open addressing hash table with linear probing, which stores the codes of the values, used for encoding*/
+	std::vector<Code> slots_;
+	/*! true, if the codes are assigned in the order of the values*/
+	bool order_preserving_;
+	/*! marks a free code in references_*/
+	static const unsigned int free_code = ~0u;
+	/*! number of rows of all columns sharing the dictionary that store a code, free_code for codes without a value*/
+	std::vector<unsigned int> references_;
+	/*! codes that were freed, their old values stay in values_ until the code is reused*/
+	std::vector<Code> free_codes_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	DictionaryValues<T>::DictionaryValues() : values_(){
+
+	}
+
+	template<class T>
+	void DictionaryValues<T>::push_back(const T& value){
+		values_.push_back(value);
+	}
+
+	template<class T>
+	void DictionaryValues<T>::set(Code code, const T& value){
+		values_[code]=value;
+	}
+
+	template<class T>
+	inline void DictionaryValues<T>::get(Code code, T& value) const{
+		value=values_[code];
+	}
+
+	template<class T>
+	inline bool DictionaryValues<T>::equals(Code code, const T& value) const{
+		return values_[code]==value;
+	}
+
+	template<class T>
+	inline bool DictionaryValues<T>::less(Code code, const T& value) const{
+		return values_[code]<value;
+	}
+
+	template<class T>
+	inline bool DictionaryValues<T>::less(const T& value, Code code) const{
+		return value<values_[code];
+	}
+
+	template<class T>
+	inline bool DictionaryValues<T>::less(Code code1, Code code2) const{
+		return values_[code1]<values_[code2];
+	}
+
+	template<class T>
+	inline std::size_t DictionaryValues<T>::hash(Code code) const{
+		return boost::hash<T>()(values_[code]);
+	}
+
+	template<class T>
+	size_t DictionaryValues<T>::size() const throw(){
+		return values_.size();
+	}
+
+	template<class T>
+	void DictionaryValues<T>::permute(const std::vector<Code>& order){
+		std::vector<T> permuted_values(order.size());
+		for(Code code=0;code<order.size();++code){
+			permuted_values[code]=values_[order[code]];
+		}
+		std::swap(values_,permuted_values);
+	}
+
+	template<class T>
+	unsigned int DictionaryValues<T>::getSizeinBytes() const throw(){
+		return values_.capacity()*sizeof(T);
+	}
+
+	inline DictionaryValues<std::string>::DictionaryValues() : heap_(), begins_(), lengths_(), dead_bytes_(0){
+
+	}
+
+	inline void DictionaryValues<std::string>::push_back(const std::string& value){
+		begins_.push_back(heap_.size());
+		lengths_.push_back(Length(value.size()));
+		heap_.insert(heap_.end(),value.begin(),value.end());
+	}
+
+	inline void DictionaryValues<std::string>::set(Code code, const std::string& value){
+		//a value that fits is written over the old one, a longer one goes to the end of the heap
+		if(value.size()>length(code)){
+			dead_bytes_ += length(code);
+			begins_[code]=heap_.size();
+			heap_.insert(heap_.end(),value.begin(),value.end());
+		}else{
+			dead_bytes_ += length(code)-value.size();
+			std::copy(value.begin(),value.end(),heap_.begin()+begins_[code]);
+		}
+		lengths_[code]=Length(value.size());
+		//the dead characters are reclaimed once they make up half of the heap, so the cost of packing is amortized over the replaced values
+		if(2*dead_bytes_>heap_.size()){
+			std::vector<Code> order(size());
+			for(Code next=0;next<order.size();++next){
+				order[next]=next;
+			}
+			pack(order);
+		}
+	}
+
+	inline const char* DictionaryValues<std::string>::data(Code code) const{
+		//an empty heap has no valid address, but then all values are empty anyway
+		return heap_.empty() ? "" : &heap_[0]+begins_[code];
+	}
+
+	inline size_t DictionaryValues<std::string>::length(Code code) const{
+		return lengths_[code];
+	}
+
+	inline int DictionaryValues<std::string>::compare(const char* str1, size_t length1, const char* str2, size_t length2){
+		int result = std::memcmp(str1,str2,std::min(length1,length2));
+		if(result!=0) return result;
+		if(length1<length2) return -1;
+		return length1>length2 ? 1 : 0;
+	}
+
+	inline void DictionaryValues<std::string>::get(Code code, std::string& value) const{
+		value.assign(data(code),length(code));
+	}
+
+	inline bool DictionaryValues<std::string>::equals(Code code, const std::string& value) const{
+		return length(code)==value.size() && std::memcmp(data(code),value.data(),value.size())==0;
+	}
+
+	inline bool DictionaryValues<std::string>::less(Code code, const std::string& value) const{
+		return compare(data(code),length(code),value.data(),value.size())<0;
+	}
+
+	inline bool DictionaryValues<std::string>::less(const std::string& value, Code code) const{
+		return compare(value.data(),value.size(),data(code),length(code))<0;
+	}
+
+	inline bool DictionaryValues<std::string>::less(Code code1, Code code2) const{
+		return compare(data(code1),length(code1),data(code2),length(code2))<0;
+	}
+
+	inline std::size_t DictionaryValues<std::string>::hash(Code code) const{
+		//the same hash value as boost::hash<std::string> computes for the value
+		return boost::hash_range(data(code),data(code)+length(code));
+	}
+
+	inline size_t DictionaryValues<std::string>::size() const throw(){
+		return begins_.size();
+	}
+
+	inline void DictionaryValues<std::string>::permute(const std::vector<Code>& order){
+		pack(order);
+	}
+
+	inline void DictionaryValues<std::string>::pack(const std::vector<Code>& order){
+		std::vector<char> packed_heap;
+		packed_heap.reserve(heap_.size()-dead_bytes_);
+		std::vector<Offset> packed_begins;
+		packed_begins.reserve(order.size());
+		std::vector<Length> packed_lengths;
+		packed_lengths.reserve(order.size());
+		for(Code code=0;code<order.size();++code){
+			packed_begins.push_back(packed_heap.size());
+			packed_lengths.push_back(lengths_[order[code]]);
+			packed_heap.insert(packed_heap.end(),data(order[code]),data(order[code])+length(order[code]));
+		}
+		std::swap(heap_,packed_heap);
+		std::swap(begins_,packed_begins);
+		std::swap(lengths_,packed_lengths);
+		dead_bytes_=0;
+	}
+
+	inline unsigned int DictionaryValues<std::string>::getSizeinBytes() const throw(){
+		return heap_.capacity()+begins_.capacity()*sizeof(Offset)+lengths_.capacity()*sizeof(Length);
+	}
+
+	template<class T>
+	Dictionary<T>::Dictionary() : values_(), slots_(16,empty_slot), order_preserving_(true), references_(), free_codes_(){
+
+	}
+
+	template<class T>
+	inline size_t Dictionary<T>::findSlot(const T& value) const{
+		const size_t mask = slots_.size()-1;
+		size_t slot = boost::hash<T>()(value) & mask;
+		while(slots_[slot]!=empty_slot && !values_.equals(slots_[slot],value)){
+			slot = (slot+1) & mask;
+		}
+		return slot;
+	}
+
+	template<class T>
+	const typename Dictionary<T>::Code Dictionary<T>::empty_slot;
+
+	template<class T>
+	const unsigned int Dictionary<T>::free_code;
+
+	template<class T>
+	void Dictionary<T>::rehash(size_t number_of_slots){
+		std::vector<Code> slots(number_of_slots,empty_slot);
+		const size_t mask = slots.size()-1;
+		for(Code code=0;code<values_.size();++code){
+			if(references_[code]==free_code) continue;
+			size_t slot = values_.hash(code) & mask;
+			while(slots[slot]!=empty_slot){
+				slot = (slot+1) & mask;
+			}
+			slots[slot]=code;
+		}
+		std::swap(slots_,slots);
+	}
+
+	template<class T>
+	typename Dictionary<T>::Code Dictionary<T>::encode(const T& value){
+		//a single probe sequence in the hash table, which either finds the existing code or the slot for the new one
+		size_t slot = findSlot(value);
+		if(slots_[slot]!=empty_slot){
+			return slots_[slot];
+		}
+		Code code;
+		if(!free_codes_.empty()){
+			//a free code is reused, so the dictionary does not grow while rows are updated or removed
+			code = free_codes_.back();
+			free_codes_.pop_back();
+			values_.set(code,value);
+			references_[code]=0;
+			//the old values of free codes stay in place, so the order is intact if the value fits between its neighbours
+			if((code>0 && !values_.less(code-1,code)) || (code+1<values_.size() && !values_.less(code,code+1))){
+				order_preserving_=false;
+			}
+		}else{
+			code = static_cast<Code>(values_.size());
+			//a new value keeps the code order intact only, if it is larger than all values in the dictionary
+			if(code>0 && !values_.less(code-1,value)){
+				order_preserving_=false;
+			}
+			values_.push_back(value);
+			references_.push_back(0);
+		}
+		slots_[slot]=code;
+		//keep the load factor of the hash table below one half
+		if(2*values_.size()>slots_.size()){
+			rehash(2*slots_.size());
+		}
+		return code;
+	}
+
+	template<class T>
+	bool Dictionary<T>::find(const T& value, Code& code) const{
+		size_t slot = findSlot(value);
+		if(slots_[slot]==empty_slot) return false;
+		code=slots_[slot];
+		return true;
+	}
+
+	template<class T>
+	inline T Dictionary<T>::decode(Code code) const{
+		T value;
+		values_.get(code,value);
+		return value;
+	}
+
+	template<class T>
+	inline void Dictionary<T>::decode(Code code, T& value) const{
+		values_.get(code,value);
+	}
+
+	template<class T>
+	inline bool Dictionary<T>::less(Code code, const T& value) const{
+		return values_.less(code,value);
+	}
+
+	template<class T>
+	inline bool Dictionary<T>::less(const T& value, Code code) const{
+		return values_.less(value,code);
+	}
+
+	template<class T>
+	size_t Dictionary<T>::size() const throw(){
+		return values_.size();
+	}
+
+	template<class T>
+	inline void Dictionary<T>::addReference(Code code, unsigned int number_of_rows){
+		references_[code]+=number_of_rows;
+	}
+
+	template<class T>
+	inline void Dictionary<T>::removeReference(Code code){
+		if(--references_[code]==0){
+			release(code);
+		}
+	}
+
+	template<class T>
+	void Dictionary<T>::resetReferences(){
+		for(Code code=0;code<references_.size();++code){
+			if(references_[code]!=free_code){
+				references_[code]=0;
+			}
+		}
+	}
+
+	template<class T>
+	void Dictionary<T>::releaseUnusedCodes(){
+		for(Code code=0;code<references_.size();++code){
+			if(references_[code]==0){
+				release(code);
+			}
+		}
+	}
+
+	template<class T>
+	size_t Dictionary<T>::getNumberOfFreeCodes() const throw(){
+		return free_codes_.size();
+	}
+
+	template<class T>
+	void Dictionary<T>::release(Code code){
+		const size_t mask = slots_.size()-1;
+		size_t slot = values_.hash(code) & mask;
+		while(slots_[slot]!=code){
+			slot = (slot+1) & mask;
+		}
+		//the following codes of the probe sequence move backwards into the gap, unless that would put them in front of their home slot
+		for(size_t next=(slot+1) & mask;slots_[next]!=empty_slot;next=(next+1) & mask){
+			size_t home = values_.hash(slots_[next]) & mask;
+			if(((next-home) & mask) >= ((next-slot) & mask)){
+				slots_[slot]=slots_[next];
+				slot=next;
+			}
+		}
+		slots_[slot]=empty_slot;
+		references_[code]=free_code;
+		free_codes_.push_back(code);
+	}
+
+	template<class T>
+	void Dictionary<T>::compact(std::vector<Code>& new_codes){
+		new_codes.assign(values_.size(),empty_slot);
+		std::vector<Code> used_codes;
+		std::vector<unsigned int> references;
+		for(Code code=0;code<values_.size();++code){
+			if(references_[code]!=free_code){
+				new_codes[code]=static_cast<Code>(used_codes.size());
+				used_codes.push_back(code);
+				references.push_back(references_[code]);
+			}
+		}
+		values_.permute(used_codes);
+		std::swap(references_,references);
+		free_codes_.clear();
+		size_t number_of_slots=16;
+		while(2*values_.size()>number_of_slots){
+			number_of_slots*=2;
+		}
+		rehash(number_of_slots);
+	}
+
+	template<class T>
+	bool Dictionary<T>::isOrderPreserving() const throw(){
+		return order_preserving_;
+	}
+
+	/*! \brief orders codes by the values they represent*/
+	template<class T>
+	struct DictionaryCodeComparator{
+		explicit DictionaryCodeComparator(const DictionaryValues<T>& values) : values_(values){}
+		bool operator()(typename DictionaryValues<T>::Code code1, typename DictionaryValues<T>::Code code2) const{
+			return values_.less(code1,code2);
+		}
+		const DictionaryValues<T>& values_;
+	};
+
+	template<class T>
+	void Dictionary<T>::makeOrderPreserving(std::vector<Code>& new_codes){
+		getRanks(new_codes);
+		std::vector<Code> order(values_.size());
+		for(Code code=0;code<order.size();++code){
+			order[new_codes[code]]=code;
+		}
+		values_.permute(order);
+		std::vector<unsigned int> references(references_.size());
+		for(Code code=0;code<order.size();++code){
+			references[code]=references_[order[code]];
+		}
+		std::swap(references_,references);
+		for(size_t i=0;i<free_codes_.size();++i){
+			free_codes_[i]=new_codes[free_codes_[i]];
+		}
+		//the hash table keeps its layout, only the codes in the slots change
+		for(size_t slot=0;slot<slots_.size();++slot){
+			if(slots_[slot]!=empty_slot){
+				slots_[slot]=new_codes[slots_[slot]];
+			}
+		}
+		order_preserving_=true;
+	}
+
+	template<class T>
+	void Dictionary<T>::getRanks(std::vector<Code>& ranks) const{
+		ranks.resize(values_.size());
+		for(Code code=0;code<ranks.size();++code){
+			ranks[code]=code;
+		}
+		if(order_preserving_) return;
+		std::vector<Code> order(ranks);
+		std::sort(order.begin(),order.end(),DictionaryCodeComparator<T>(values_));
+		for(Code code=0;code<order.size();++code){
+			ranks[order[code]]=code;
+		}
+	}
+
+	template<class T>
+	typename Dictionary<T>::Code Dictionary<T>::lowerBound(const T& value) const{
+		Code first=0, count=static_cast<Code>(values_.size());
+		while(count>0){
+			Code step=count/2;
+			if(values_.less(first+step,value)){
+				first+=step+1;
+				count-=step+1;
+			}else{
+				count=step;
+			}
+		}
+		return first;
+	}
+
+	template<class T>
+	typename Dictionary<T>::Code Dictionary<T>::upperBound(const T& value) const{
+		Code first=0, count=static_cast<Code>(values_.size());
+		while(count>0){
+			Code step=count/2;
+			if(!values_.less(value,first+step)){
+				first+=step+1;
+				count-=step+1;
+			}else{
+				count=step;
+			}
+		}
+		return first;
+	}
+
+	template<class T>
+	void Dictionary<T>::rebuild(){
+		//the rows are not stored with the dictionary, the columns count them again
+		references_.assign(values_.size(),0);
+		free_codes_.clear();
+		size_t number_of_slots=16;
+		while(2*values_.size()>number_of_slots){
+			number_of_slots*=2;
+		}
+		rehash(number_of_slots);
+		order_preserving_=true;
+		for(Code code=1;code<values_.size() && order_preserving_;++code){
+			order_preserving_ = values_.less(code-1,code);
+		}
+	}
+
+	template<class T>
+	unsigned int Dictionary<T>::getSizeinBytes() const throw(){
+		return values_.getSizeinBytes()+slots_.capacity()*sizeof(Code)+references_.capacity()*sizeof(unsigned int)+free_codes_.capacity()*sizeof(Code);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
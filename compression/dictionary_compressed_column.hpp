@@ -12,8 +12,12 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <core/column.hpp>
+#include <compression/bit_packed_vector.hpp>
+#include <compression/dictionary.hpp>
 #include <boost/type_traits/remove_const.hpp>
-#include <boost/serialization/map.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind/bind.hpp>
 
 namespace CoGaDB{
 	
@@ -24,21 +28,34 @@ namespace CoGaDB{
 template<class T>
 class DictionaryCompressedColumn : public CompressedColumn<T>{
 	public:
+	/*! \brief defines a smart pointer to a Dictionary, which may be shared by several columns*/
+	typedef shared_pointer_namespace::shared_ptr<Dictionary<T> > DictionaryPtr;
 	/***************** constructors and destructor *****************/
 	DictionaryCompressedColumn(const std::string& name, AttributeType db_type);
+	/*! \brief creates a column that encodes its values with an existing dictionary, which it shares with other columns*/
+	DictionaryCompressedColumn(const std::string& name, AttributeType db_type, DictionaryPtr dictionary);
 	virtual ~DictionaryCompressedColumn();
 
 	virtual bool insert(const boost::any& new_Value);
 	virtual bool insert(const T& new_value);
+	/*! \brief appends the values in [first,last), uses all hardware threads to encode them*/
 	template <typename InputIterator>
 	bool insert(InputIterator first, InputIterator last);
+	/*! \brief appends the values in [first,last), the values are encoded in parallel by number_of_threads threads
+	 *  \details a bulk load into an empty column creates an order preserving dictionary*/
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last, unsigned int number_of_threads);
 
 	virtual bool update(TID tid, const boost::any& new_value);
 	virtual bool update(PositionListPtr tid, const boost::any& new_value);	
+	/*! \brief encodes the new value once and writes its code to the rows of every interval*/
+	virtual bool update(PositionIntervalListPtr tids, const boost::any& new_value);
 	
 	virtual bool remove(TID tid);
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid);
+	/*! \brief removes the rows of all intervals in one pass, which releases their codes and moves the rows between the intervals to the front*/
+	virtual bool remove(PositionIntervalListPtr tids);
 	virtual bool clearContent();
 
 	virtual const boost::any get(TID tid);
@@ -52,23 +69,102 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 
-
+	/***************** relational operations evaluated on the codes *****************/
+	/*! \brief sorts the tids with a counting sort over the codes in O(n + dictionary size) without decoding any value
+	 *  \details equal values keep the tid order of ColumnBaseTyped<T>::sort, which is ascending for ASCENDING and descending for DESCENDING*/
+	virtual const PositionListPtr sort(SortOrder order);
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column);
+	/*! \brief groups the rows by the values of this column and aggregates the corresponding rows of the column values per group
+	 *  \details the codes index the accumulators of the groups directly, so no hashing is required. Every thread aggregates a part of the rows
+	 *  into its own accumulators, which are merged afterwards. The keys are decoded once per group at the end.
+	 *  \return a pair of materialized columns, the first contains the keys in ascending order, the second the aggregates of the groups*/
+	template <typename U>
+	std::pair<ColumnPtr,ColumnPtr> aggregate_by_keys(ColumnBaseTyped<U>& values, AggregationMethod agg_meth, unsigned int number_of_threads=boost::thread::hardware_concurrency());
+
+	/*! \brief returns true, if the order of the codes matches the order of the values, so that range predicates can be evaluated on the codes*/
+	bool isOrderPreserving() const throw();
+	/*! \brief sorts the dictionary and renumbers the codes of all rows, so that the code order matches the value order
+	 *  \details a shared dictionary is copied first, because the codes of the other columns would be invalidated otherwise*/
+	void makeOrderPreserving();
+	/*! \brief returns the dictionary, which can be passed to other columns to share it*/
+	DictionaryPtr getDictionary() const;
+	/*! \brief drops the free codes from the dictionary, renumbers the codes of all rows densely and narrows the code width
+	 *  \details Codes that no row stores anymore are freed and reused by new values right away, so the dictionary does not grow
+	 *  under updates. A compaction additionally shrinks a dictionary whose number of distinct values went down for good.
+	 *  It rewrites the codes of all rows in one pass, so it is meant to be run rarely, e.g., after a large delete.
+	 *  \return false, if the dictionary is shared, because the codes of the other columns would be invalidated*/
+	bool compactDictionary();
 	
 	virtual T& operator[](const int index);
-	std::vector<T>& getContent();
+
+	/*! \brief type of the integer codes which replace the values of the column*/
+	typedef typename Dictionary<T>::Code Code;
+	BitPackedVector& getContent();
 
 	private:
+	/*! \brief describes the codes which satisfy a filter condition, either all codes in [lower,upper) or the codes flagged in matching_codes*/
+	struct CodePredicate{
+		CodePredicate() : lower(0), upper(0), matching_codes(){}
+		Code lower;
+		Code upper;
+		std::vector<char> matching_codes;
+	};
+	/*! \brief dictionary of a part of a bulk load, which is built by one thread without synchronization*/
+	struct LocalDictionary{
+		LocalDictionary() : codes(), values(), row_codes(), global_codes(), counts(){}
+		/*! maps a value to its local code*/
+		boost::unordered_map<T,Code> codes;
+		/*! maps a local code to its value*/
+		std::vector<T> values;
+		/*! local codes of the rows of the part*/
+		std::vector<Code> row_codes;
+		/*! maps a local code to its code in the dictionary of the column*/
+		std::vector<Code> global_codes;
+		/*! number of rows of the part per local code*/
+		std::vector<unsigned int> counts;
+	};
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last, unsigned int number_of_threads, std::input_iterator_tag);
+	template <typename RandomAccessIterator>
+	bool insert(RandomAccessIterator first, RandomAccessIterator last, unsigned int number_of_threads, std::random_access_iterator_tag);
+	template <typename RandomAccessIterator>
+	static void encodeLocally(RandomAccessIterator first, RandomAccessIterator last, LocalDictionary* local_dictionary);
+	/*! \brief writes the global codes of a part of a bulk load to the rows starting at position begin*/
+	void writeCodes(size_t begin, const LocalDictionary* local_dictionary);
+	/*! \brief returns the code of value, adds value to the dictionary if it is not yet contained*/
+	Code encode(const T& value);
+	/*! \brief adds the rows of the column to the reference counts of the dictionary*/
+	void addReferences() const;
+	/*! \brief removes the rows of the column from the reference counts of the dictionary*/
+	void releaseReferences();
+	/*! \brief counts the rows per code again after the column got a dictionary of its own*/
+	void recountReferences();
+	/*! \brief translates a filter condition on values into a filter condition on codes
+	 *  \return false, if no row can satisfy the filter condition*/
+	bool translatePredicate(const T& value, const ValueComparator comp, CodePredicate& predicate) const;
+	/*! \brief appends the tids in [begin,end) whose codes satisfy the predicate to result*/
+	void scanCodes(const CodePredicate& predicate, TID begin, TID end, PositionList& result) const;
+	/*! \brief aggregates the values of the rows in [begin,end) into the accumulators of their codes, seen flags the codes that occured*/
+	template <typename U>
+	void aggregateCodes(const U* values, TID begin, TID end, AggregationMethod agg_meth, std::vector<U>* aggregates, std::vector<char>* seen) const;
+	/*! \brief orders pairs of a key and an aggregate by the key*/
+	struct KeyComparator{
+		template <typename Pair>
+		inline bool operator() (const Pair& i, const Pair& j) const { return i.first<j.first; }
+	};
 
 		struct Type_TID_Comparator {
   			inline bool operator() (std::pair<T,TID> i, std::pair<T,TID> j) { return (i.first<j.first);}
 		} type_tid_comparator;
 
 
-	std::vector<T> values_;
-	std::map<T,T> dictionary;
-	 
-	T it;
-	int cnt;
+	/*! codes of the rows, packed with the minimal number of bits required for the current dictionary size*/
+	BitPackedVector values_;
+	/*! maps values to codes and back, may be shared with other columns*/
+	DictionaryPtr dictionary_;
+	/*! decoded value returned by operator[]*/
 	T key;
 
 };
@@ -77,17 +173,25 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 
 	
 	template<class T>
-	DictionaryCompressedColumn<T>::DictionaryCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type), type_tid_comparator(), values_(), dictionary(), it(), cnt(), key(){
+	DictionaryCompressedColumn<T>::DictionaryCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type), type_tid_comparator(), values_(), dictionary_(new Dictionary<T>()), key(){
 
 	}
 
 	template<class T>
-	DictionaryCompressedColumn<T>::~DictionaryCompressedColumn(){
+	DictionaryCompressedColumn<T>::DictionaryCompressedColumn(const std::string& name, AttributeType db_type, DictionaryPtr dictionary) : CompressedColumn<T>(name, db_type), type_tid_comparator(), values_(BitPackedVector::bitsFor(dictionary->size())), dictionary_(dictionary), key(){
 
 	}
 
 	template<class T>
-	std::vector<T>& DictionaryCompressedColumn<T>::getContent(){
+	DictionaryCompressedColumn<T>::~DictionaryCompressedColumn(){
+		//the other columns sharing the dictionary may reuse the codes of our rows
+		if(!dictionary_.unique()){
+			releaseReferences();
+		}
+	}
+
+	template<class T>
+	BitPackedVector& DictionaryCompressedColumn<T>::getContent(){
 		return values_;
 	}
 
@@ -96,46 +200,56 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
 			 T value = boost::any_cast<T>(new_value);
-			 values_.push_back(value);
-			 return true;
+			 return insert(value);
 		}
 		return false;
 	}
 
 	template<class T>
-	bool DictionaryCompressedColumn<T>::insert(const T& new_value){
+	typename DictionaryCompressedColumn<T>::Code DictionaryCompressedColumn<T>::encode(const T& value){
+		Code code = dictionary_->encode(value);
+		//the dictionary outgrew the code width (possibly through another column sharing it), so we repack the codes
+		unsigned int bits = BitPackedVector::bitsFor(dictionary_->size());
+		if(bits>values_.getBitsPerValue()){
+			values_.setBitsPerValue(bits);
+		}
+		return code;
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::addReferences() const{
+		for(size_t i=0;i<values_.size();++i){
+			dictionary_->addReference(values_[i]);
+		}
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::releaseReferences(){
+		for(size_t i=0;i<values_.size();++i){
+			dictionary_->removeReference(values_[i]);
+		}
+	}
 
-		typename std::map<T,T>::iterator it1;
-		 it1 = dictionary.find(new_value);
-		  
-            if (it1 != dictionary.end())
-            {
-            	//found
-       			values_.push_back(dictionary[new_value]); 
-            }
-            else
-            {
-				dictionary.insert(std::pair<T,T>(new_value,it));
-                values_.push_back(it);
-		        cnt++;
-                it = boost::lexical_cast<T> (cnt);
-            }
+	template<class T>
+	void DictionaryCompressedColumn<T>::recountReferences(){
+		dictionary_->resetReferences();
+		addReferences();
+		dictionary_->releaseUnusedCodes();
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::insert(const T& new_value){
+		Code code = encode(new_value);
+		dictionary_->addReference(code);
+		values_.push_back(code);
 	    return true;
 	}
 
-		template<class T>
+	template<class T>
 	T& DictionaryCompressedColumn<T>::operator[](const int index){
-		T value = values_[index];
-		
-		typename std::map<T,T>::iterator it;
-		for (it = dictionary.begin(); it != dictionary.end(); ++it)
-        {
-            if (it->second == value)
-            {
-               key = it->first;
-              //std::cout <<"compiler love you if you print this"<< key << std::endl;  
-            }
-        }
+		//the code is the position of the value in the dictionary,
+		//we return a copy, so that writes through the reference cannot corrupt the dictionary
+		dictionary_->decode(values_[index],key);
 		return key;
 	}
 
@@ -143,14 +257,113 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	template <typename T> 
 	template <typename InputIterator>
 	bool DictionaryCompressedColumn<T>::insert(InputIterator first , InputIterator last){
-		this->values_.insert(this->values_.end(),first,last);
+		return insert(first,last,std::max(1u,boost::thread::hardware_concurrency()));
+	}
+
+	template <typename T> 
+	template <typename InputIterator>
+	bool DictionaryCompressedColumn<T>::insert(InputIterator first , InputIterator last, unsigned int number_of_threads){
+		return insert(first,last,number_of_threads,typename std::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	template <typename T> 
+	template <typename InputIterator>
+	bool DictionaryCompressedColumn<T>::insert(InputIterator first , InputIterator last, unsigned int number_of_threads, std::input_iterator_tag){
+		//the input has to be split into parts, which requires random access
+		std::vector<T> buffer(first,last);
+		return insert(buffer.begin(),buffer.end(),number_of_threads,std::random_access_iterator_tag());
+	}
+
+	template <typename T> 
+	template <typename RandomAccessIterator>
+	void DictionaryCompressedColumn<T>::encodeLocally(RandomAccessIterator first, RandomAccessIterator last, LocalDictionary* local_dictionary){
+		local_dictionary->row_codes.reserve(last-first);
+		for(;first!=last;++first){
+			Code code = static_cast<Code>(local_dictionary->values.size());
+			std::pair<typename boost::unordered_map<T,Code>::iterator,bool> result = local_dictionary->codes.insert(std::make_pair(*first,code));
+			if(result.second){
+				local_dictionary->values.push_back(*first);
+				local_dictionary->counts.push_back(0);
+			}
+			local_dictionary->row_codes.push_back(result.first->second);
+			local_dictionary->counts[result.first->second]++;
+		}
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::writeCodes(size_t begin, const LocalDictionary* local_dictionary){
+		for(size_t i=0;i<local_dictionary->row_codes.size();++i){
+			values_.set(begin+i,local_dictionary->global_codes[local_dictionary->row_codes[i]]);
+		}
+	}
+
+	template <typename T> 
+	template <typename RandomAccessIterator>
+	bool DictionaryCompressedColumn<T>::insert(RandomAccessIterator first , RandomAccessIterator last, unsigned int number_of_threads, std::random_access_iterator_tag){
+		const size_t old_size = values_.size();
+		const size_t number_of_rows = last-first;
+		const bool bulk_load = (old_size==0);
+		//small inputs are not worth the threads
+		const size_t min_rows_per_thread = 64*1024;
+		number_of_threads = std::max<size_t>(1,std::min<size_t>(number_of_threads,number_of_rows/min_rows_per_thread));
+
+		//the parts start at row positions that are multiples of 64, so every part writes its own words of the packed codes
+		std::vector<size_t> part_begin(number_of_threads+1);
+		const size_t rows_per_thread = (number_of_rows+number_of_threads-1)/number_of_threads;
+		part_begin[0]=old_size;
+		for(unsigned int t=1;t<number_of_threads;t++){
+			part_begin[t] = std::min(old_size+number_of_rows,(old_size+t*rows_per_thread+63)/64*64);
+		}
+		part_begin[number_of_threads]=old_size+number_of_rows;
+
+		//phase 1: every thread encodes its part with a local dictionary
+		std::vector<LocalDictionary> local_dictionaries(number_of_threads);
+		boost::thread_group threads;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			threads.create_thread(boost::bind(&DictionaryCompressedColumn<T>::template encodeLocally<RandomAccessIterator>,
+				first+(part_begin[t]-old_size),first+(part_begin[t+1]-old_size),&local_dictionaries[t]));
+		}
+		threads.join_all();
+
+		//phase 2: the local dictionaries are merged into the global dictionary, which only touches the distinct values
+		for(unsigned int t=0;t<number_of_threads;t++){
+			LocalDictionary& local_dictionary = local_dictionaries[t];
+			local_dictionary.global_codes.resize(local_dictionary.values.size());
+			for(Code code=0;code<local_dictionary.values.size();++code){
+				local_dictionary.global_codes[code]=dictionary_->encode(local_dictionary.values[code]);
+				dictionary_->addReference(local_dictionary.global_codes[code],local_dictionary.counts[code]);
+			}
+		}
+		//a bulk load into an empty column gets an order preserving dictionary, unless the dictionary is shared
+		if(bulk_load && dictionary_.unique() && !dictionary_->isOrderPreserving()){
+			std::vector<Code> new_codes;
+			dictionary_->makeOrderPreserving(new_codes);
+			for(unsigned int t=0;t<number_of_threads;t++){
+				std::vector<Code>& global_codes = local_dictionaries[t].global_codes;
+				for(Code code=0;code<global_codes.size();++code){
+					global_codes[code]=new_codes[global_codes[code]];
+				}
+			}
+		}
+		unsigned int bits = BitPackedVector::bitsFor(dictionary_->size());
+		if(bits>values_.getBitsPerValue()){
+			values_.setBitsPerValue(bits);
+		}
+
+		//phase 3: every thread writes the global codes of its part
+		values_.resize(old_size+number_of_rows);
+		boost::thread_group writer_threads;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			writer_threads.create_thread(boost::bind(&DictionaryCompressedColumn<T>::writeCodes,this,part_begin[t],&local_dictionaries[t]));
+		}
+		writer_threads.join_all();
 		return true;
 	}
 
 	template<class T>
 	const boost::any DictionaryCompressedColumn<T>::get(TID tid){
 				if(tid<values_.size())
- 			return boost::any(values_[tid]);
+ 			return boost::any(dictionary_->decode(values_[tid]));
 		else{
 			std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid  << std::endl;
 		}
@@ -163,7 +376,7 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		std::cout << "| " << this->name_ << " |" << std::endl;
 		std::cout << "________________________" << std::endl;
 		for(unsigned int i=0;i<values_.size();i++){
-			std::cout << "| " << values_[i] << " |" << std::endl;
+			std::cout << "| " << dictionary_->decode(values_[i]) << " |" << std::endl;
 		}
 	}
 	template<class T>
@@ -172,7 +385,10 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	}
 	template<class T>
 	const ColumnPtr DictionaryCompressedColumn<T>::copy() const{
-		return ColumnPtr(new DictionaryCompressedColumn<T>(*this));
+		//the copy shares the dictionary, so its rows count as well
+		ColumnPtr column(new DictionaryCompressedColumn<T>(*this));
+		addReferences();
+		return column;
 	}
 
 	template<class T>
@@ -181,21 +397,12 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		if(new_value.empty()) return false;
 		
 		T v =boost::any_cast<T>(new_value);
-
-	    typename std::map<T,T>::iterator it;
-		for (it = dictionary.begin(); it != dictionary.end(); ++it)
-        {
-        	if(it->first == v) {
-        		values_[tid] = it->second;
-        		break;
-        	}
-             else
-            {
-               	T t = boost::lexical_cast<T> (++cnt);
-               	values_[tid] = t;
-               	dictionary.insert(std::pair<T,T>(v,t));
-  			}
-        }
+		Code old_code = values_[tid];
+		Code code = encode(v);
+		dictionary_->addReference(code);
+		values_.set(tid,code);
+		//releasing the old code last keeps it alive, if the value did not change
+		dictionary_->removeReference(old_code);
     	return true;
 	}
 
@@ -205,10 +412,13 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 			return false;
 	    if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
-			 T value = boost::any_cast<T>(new_value);
+			 Code code = encode(boost::any_cast<T>(new_value));
+			 dictionary_->addReference(code,tids->size());
 			 for(unsigned int i=0;i<tids->size();i++){
 				TID tid=(*tids)[i];
-				values_[tid]=value;
+				Code old_code = values_[tid];
+				values_.set(tid,code);
+				dictionary_->removeReference(old_code);
 		    }
 			return true;
 		}else{
@@ -217,9 +427,54 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		return false;	
 	}
 	
+	template<class T>
+	bool DictionaryCompressedColumn<T>::update(PositionIntervalListPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		if(new_value.empty()) return false;
+		if(typeid(T)!=new_value.type()){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			return false;
+		}
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(tids->empty()) return true;
+		if(tids->rbegin()->second>values_.size()) return false;
+		Code code = encode(boost::any_cast<T>(new_value));
+		dictionary_->addReference(code,tids->size());
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			for(TID tid=it->first;tid<it->second;++tid){
+				Code old_code = values_[tid];
+				values_.set(tid,code);
+				dictionary_->removeReference(old_code);
+			}
+		}
+		return true;
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::remove(PositionIntervalListPtr tids){
+		if(!tids) return false;
+		if(tids->empty()) return false;
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(tids->rbegin()->second>values_.size()) return false;
+		size_t kept = tids->begin()->first;
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			for(TID tid=it->first;tid<it->second;++tid){
+				dictionary_->removeReference(values_[tid]);
+			}
+			//the rows up to the next interval move behind the rows kept so far
+			const TID next_begin = it+1==tids->end() ? TID(values_.size()) : (it+1)->first;
+			for(TID tid=it->second;tid<next_begin;++tid){
+				values_.set(kept++,values_[tid]);
+			}
+		}
+		values_.resize(kept);
+		return true;
+	}
+
 	template<class T>
 	bool DictionaryCompressedColumn<T>::remove(TID tid){
-		values_.erase(values_.begin()+tid);
+		dictionary_->removeReference(values_[tid]);
+		values_.erase(tid);
 		return true;	
 	}
 	
@@ -233,17 +488,343 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 
 		typename PositionList::reverse_iterator rit;
 
-		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit)
-			values_.erase(values_.begin()+(*rit));
+		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit){
+			dictionary_->removeReference(values_[*rit]);
+			values_.erase(*rit);
+		}
 		return true;			
 	}
 
 	template<class T>
 	bool DictionaryCompressedColumn<T>::clearContent(){
+		releaseReferences();
 		values_.clear();
 		return true;
 	}
 
+	template<class T>
+	bool DictionaryCompressedColumn<T>::isOrderPreserving() const throw(){
+		return dictionary_->isOrderPreserving();
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::makeOrderPreserving(){
+		if(dictionary_->isOrderPreserving()) return;
+		//renumbering a shared dictionary would invalidate the codes of the other columns, so we detach from it
+		if(!dictionary_.unique()){
+			releaseReferences();
+			dictionary_ = DictionaryPtr(new Dictionary<T>(*dictionary_));
+			recountReferences();
+		}
+		std::vector<Code> new_codes;
+		dictionary_->makeOrderPreserving(new_codes);
+		for(size_t i=0;i<values_.size();++i){
+			values_.set(i,new_codes[values_[i]]);
+		}
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::compactDictionary(){
+		if(!dictionary_.unique()) return false;
+		if(dictionary_->getNumberOfFreeCodes()==0) return true;
+		std::vector<Code> new_codes;
+		dictionary_->compact(new_codes);
+		BitPackedVector codes(BitPackedVector::bitsFor(dictionary_->size()));
+		codes.resize(values_.size());
+		for(size_t i=0;i<values_.size();++i){
+			codes.set(i,new_codes[values_[i]]);
+		}
+		std::swap(values_,codes);
+		return true;
+	}
+
+	template<class T>
+	typename DictionaryCompressedColumn<T>::DictionaryPtr DictionaryCompressedColumn<T>::getDictionary() const{
+		return dictionary_;
+	}
+
+	template<class T>
+	bool DictionaryCompressedColumn<T>::translatePredicate(const T& value, const ValueComparator comp, CodePredicate& predicate) const{
+		predicate.lower=0;
+		predicate.upper=0;
+		predicate.matching_codes.clear();
+		if(comp==EQUAL){
+			//a value that is not in the dictionary cannot match any row
+			Code code;
+			if(!dictionary_->find(value,code)) return false;
+			predicate.lower=code;
+			predicate.upper=code+1;
+		}else if(dictionary_->isOrderPreserving()){
+			//the constant is translated into a code boundary once, afterwards we only compare integers
+			predicate.upper=static_cast<Code>(dictionary_->size());
+			if(comp==LESSER){
+				predicate.upper = dictionary_->lowerBound(value);
+			}else if(comp==GREATER){
+				predicate.lower = dictionary_->upperBound(value);
+			}
+			if(predicate.lower>=predicate.upper) return false;
+		}else{
+			//the predicate is evaluated once per dictionary entry instead of once per row
+			predicate.matching_codes.resize(dictionary_->size());
+			for(Code code=0;code<dictionary_->size();++code){
+				if(comp==LESSER){
+					predicate.matching_codes[code] = dictionary_->less(code,value);
+				}else if(comp==GREATER){
+					predicate.matching_codes[code] = dictionary_->less(value,code);
+				}
+			}
+		}
+		return true;
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::scanCodes(const CodePredicate& predicate, TID begin, TID end, PositionList& result) const{
+		if(predicate.matching_codes.empty()){
+			values_.findRange(predicate.lower,predicate.upper,begin,end,result);
+		}else{
+			for(TID i=begin;i<end;i++){
+				if(predicate.matching_codes[values_[i]]){
+					result.push_back(i);
+				}
+			}
+		}
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::sort(SortOrder order){
+		if(order!=ASCENDING && order!=DESCENDING){
+			return ColumnBaseTyped<T>::sort(order);
+		}
+		//the rank of a code is its position in the value order, a descending sort reverses the ranks
+		std::vector<Code> ranks;
+		dictionary_->getRanks(ranks);
+		const Code number_of_codes = static_cast<Code>(ranks.size());
+		if(order==DESCENDING){
+			for(Code code=0;code<number_of_codes;code++){
+				ranks[code]=number_of_codes-1-ranks[code];
+			}
+		}
+
+		//bucket_begin[rank] becomes the first output position of the rows with this rank
+		std::vector<TID> bucket_begin(number_of_codes+1,0);
+		const TID number_of_rows = values_.size();
+		for(TID i=0;i<number_of_rows;i++){
+			bucket_begin[ranks[values_[i]]+1]++;
+		}
+		for(Code rank=0;rank<number_of_codes;rank++){
+			bucket_begin[rank+1]+=bucket_begin[rank];
+		}
+
+		PositionListPtr ids( new PositionList(number_of_rows));
+		PositionList& result = *ids;
+		if(order==ASCENDING){
+			for(TID i=0;i<number_of_rows;i++){
+				result[bucket_begin[ranks[values_[i]]]++]=i;
+			}
+		}else{
+			//rows with equal values are ordered by descending tid
+			for(TID i=number_of_rows;i>0;i--){
+				result[bucket_begin[ranks[values_[i-1]]]++]=i-1;
+			}
+		}
+		return ids;
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		if(value_for_comparison.type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		PositionListPtr result_tids( new PositionList());
+		CodePredicate predicate;
+		if(translatePredicate(boost::any_cast<T>(value_for_comparison),comp,predicate)){
+			scanCodes(predicate,0,values_.size(),*result_tids);
+		}
+		return result_tids;
+	}
+
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		if(value_for_comparison.type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		PositionListPtr result_tids( new PositionList());
+		CodePredicate predicate;
+		if(!translatePredicate(boost::any_cast<T>(value_for_comparison),comp,predicate)){
+			return result_tids;
+		}
+		if(number_of_threads==0) number_of_threads=1;
+		TID chunk_size = (values_.size()+number_of_threads-1)/number_of_threads;
+
+		//every thread scans a contiguous part of the column into its own position list
+		std::vector<PositionList> partial_results(number_of_threads);
+		boost::thread_group threads;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			TID begin = std::min<TID>(t*chunk_size,values_.size());
+			TID end = std::min<TID>(begin+chunk_size,values_.size());
+			threads.create_thread(boost::bind(&DictionaryCompressedColumn<T>::scanCodes,this,boost::cref(predicate),begin,end,boost::ref(partial_results[t])));
+		}
+		threads.join_all();
+
+		size_t result_size=0;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			result_size+=partial_results[t].size();
+		}
+		result_tids->reserve(result_size);
+		for(unsigned int t=0;t<number_of_threads;t++){
+			result_tids->insert(result_tids->end(),partial_results[t].begin(),partial_results[t].end());
+		}
+		return result_tids;
+	}
+
+	template<class T>
+	const PositionListPairPtr DictionaryCompressedColumn<T>::hash_join(ColumnPtr join_column_){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		shared_pointer_namespace::shared_ptr<DictionaryCompressedColumn<T> > join_column = shared_pointer_namespace::dynamic_pointer_cast<DictionaryCompressedColumn<T> >(join_column_);
+		//only two dictionary compressed columns can be joined on their codes
+		if(!join_column){
+			return ColumnBaseTyped<T>::hash_join(join_column_);
+		}
+
+		PositionListPairPtr join_tids( new PositionListPair());
+		join_tids->first = PositionListPtr( new PositionList() );
+		join_tids->second = PositionListPtr( new PositionList() );
+
+		//maps the codes of the join column to codes of this column, invalid_code marks values that do not occur in our dictionary
+		//for a shared dictionary, this is the identity and no value has to be hashed
+		const Code invalid_code = static_cast<Code>(dictionary_->size());
+		std::vector<Code> translated_codes(join_column->dictionary_->size());
+		for(Code code=0;code<translated_codes.size();++code){
+			if(join_column->dictionary_==dictionary_){
+				translated_codes[code]=code;
+			}else if(!dictionary_->find(join_column->dictionary_->decode(code),translated_codes[code])){
+				translated_codes[code]=invalid_code;
+			}
+		}
+
+		//build phase: instead of a hash table, we group our tids by code in a dense array (counting sort),
+		//the tids of code c are stored in tids[offsets[c]] to tids[offsets[c+1]-1]
+		std::vector<TID> offsets(dictionary_->size()+1,0);
+		for(TID i=0;i<values_.size();i++){
+			offsets[values_[i]+1]++;
+		}
+		for(size_t code=1;code<offsets.size();code++){
+			offsets[code]+=offsets[code-1];
+		}
+		std::vector<TID> tids(values_.size());
+		std::vector<TID> insert_positions(offsets.begin(),offsets.end()-1);
+		for(TID i=0;i<values_.size();i++){
+			tids[insert_positions[values_[i]]++]=i;
+		}
+
+		//probe phase: every row of the join column finds its join partners with a single array access
+		for(TID i=0;i<join_column->values_.size();i++){
+			Code code = translated_codes[join_column->values_[i]];
+			if(code==invalid_code) continue;
+			for(TID j=offsets[code];j<offsets[code+1];j++){
+				join_tids->first->push_back(tids[j]);
+				join_tids->second->push_back(i);
+			}
+		}
+		return join_tids;
+	}
+
+	template<class T>
+	template <typename U>
+	std::pair<ColumnPtr,ColumnPtr> DictionaryCompressedColumn<T>::aggregate_by_keys(ColumnBaseTyped<U>& values, AggregationMethod agg_meth, unsigned int number_of_threads){
+		if(values_.size()!=values.size()){
+			std::cout << "Fatal Error!!! Columns " << this->name_  << " and " << values.getName() << " differ in size" << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			return std::pair<ColumnPtr,ColumnPtr>();
+		}
+		if(!check_aggregation_method<U>(agg_meth,values.getName())) return std::pair<ColumnPtr,ColumnPtr>();
+		//the threads read the values concurrently, which is only safe on a plain array
+		std::vector<U> decoded_values;
+		const U* value_array = 0;
+		if(values.size()>0){
+			if(values.isMaterialized()){
+				value_array = &values[0];
+			}else{
+				decoded_values.reserve(values.size());
+				for(unsigned int i=0;i<values.size();i++){
+					decoded_values.push_back(values[i]);
+				}
+				value_array = &decoded_values[0];
+			}
+		}
+
+		if(number_of_threads==0) number_of_threads=1;
+		const size_t number_of_codes = dictionary_->size();
+		TID chunk_size = (values_.size()+number_of_threads-1)/number_of_threads;
+		std::vector<std::vector<U> > partial_aggregates(number_of_threads,std::vector<U>(number_of_codes));
+		std::vector<std::vector<char> > partial_seen(number_of_threads,std::vector<char>(number_of_codes,0));
+		boost::thread_group threads;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			TID begin = std::min<TID>(t*chunk_size,values_.size());
+			TID end = std::min<TID>(begin+chunk_size,values_.size());
+			threads.create_thread(boost::bind(&DictionaryCompressedColumn<T>::template aggregateCodes<U>,this,value_array,begin,end,agg_meth,&partial_aggregates[t],&partial_seen[t]));
+		}
+		threads.join_all();
+
+		//merge the accumulators of all threads into the ones of the first thread
+		std::vector<U>& aggregates = partial_aggregates[0];
+		std::vector<char>& seen = partial_seen[0];
+		for(unsigned int t=1;t<number_of_threads;t++){
+			for(Code code=0;code<number_of_codes;code++){
+				if(!partial_seen[t][code]) continue;
+				if(seen[code]){
+					aggregate_value(aggregates[code],partial_aggregates[t][code],agg_meth);
+				}else{
+					aggregates[code]=partial_aggregates[t][code];
+					seen[code]=1;
+				}
+			}
+		}
+
+		std::vector<std::pair<T,U> > groups;
+		for(Code code=0;code<number_of_codes;code++){
+			if(seen[code]){
+				groups.push_back(std::make_pair(dictionary_->decode(code),aggregates[code]));
+			}
+		}
+		//the codes of an order preserving dictionary already yield the groups in ascending order
+		if(!dictionary_->isOrderPreserving()){
+			std::sort(groups.begin(),groups.end(),KeyComparator());
+		}
+
+		shared_pointer_namespace::shared_ptr<Column<T> > keys( new Column<T>(this->name_,this->db_type_) );
+		shared_pointer_namespace::shared_ptr<Column<U> > result_aggregates( new Column<U>(values.getName(),values.getType()) );
+		for(size_t i=0;i<groups.size();i++){
+			keys->insert(groups[i].first);
+			result_aggregates->insert(groups[i].second);
+		}
+		return std::pair<ColumnPtr,ColumnPtr>(keys,result_aggregates);
+	}
+
+	template<class T>
+	template <typename U>
+	void DictionaryCompressedColumn<T>::aggregateCodes(const U* values, TID begin, TID end, AggregationMethod agg_meth, std::vector<U>* aggregates, std::vector<char>* seen) const{
+		std::vector<U>& accumulators = *aggregates;
+		std::vector<char>& occured = *seen;
+		for(TID i=begin;i<end;i++){
+			const Code code = values_[i];
+			if(occured[code]){
+				aggregate_value(accumulators[code],values[i],agg_meth);
+			}else{
+				accumulators[code]=values[i];
+				occured[code]=1;
+			}
+		}
+	}
+
 	template<class T>
 	bool DictionaryCompressedColumn<T>::store(const std::string& path_){
 			std::string path(path_);
@@ -259,7 +840,7 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		
 		std::ofstream outlfile (dictpath.c_str(),std::ios_base::binary | std::ios_base::out);
 		boost::archive::binary_oarchive olu(outlfile);
-		olu <<dictionary;
+		olu << *dictionary_;
 
 		outfile.flush();
 		outfile.close();
@@ -276,16 +857,24 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 		dictpath += "dictpath";
 		
 		//std::cout << "Opening File '" << path << "'..." << std::endl;
+		//the rows about to be replaced leave a shared dictionary, so that the other columns may reuse their codes
+		if(!dictionary_.unique()){
+			releaseReferences();
+		}
+		values_.clear();
 		std::ifstream infile (path.c_str(),std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ia(infile);
 		ia >> values_;
 		
 		std::ifstream infilen (dictpath.c_str(),std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ian(infilen);
-		ian >> dictionary;
+		//the loaded dictionary belongs to this column only, a dictionary shared before is left untouched
+		dictionary_ = DictionaryPtr(new Dictionary<T>());
+		ian >> *dictionary_;
+		recountReferences();
 		
 		infilen.close();
-		infile.close();}catch(std::exception e){std::cout<<"error in store";}
+		infile.close();}catch(std::exception& e){std::cout<<"error in store";}
 		return true;
 	}
 
@@ -293,16 +882,7 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 
 	template<class T>
 	unsigned int DictionaryCompressedColumn<T>::getSizeinBytes() const throw(){
-		return values_.capacity()*sizeof(T);
-	}
-
-	template<>
-	inline unsigned int DictionaryCompressedColumn<std::string>::getSizeinBytes() const throw(){
-		unsigned int size_in_bytes=0;
-		for(unsigned int i=0;i<values_.size();++i){
-			size_in_bytes+=values_[i].capacity();
-		}
-		return size_in_bytes;
+		return values_.getSizeinBytes()+dictionary_->getSizeinBytes();
 	}
 
 /***************** End of Implementation Section ******************/
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include <compression/delta_codec.hpp>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define COGADB_RUNTIME_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This block stores the deltas of at most block_size integers bit-packed relative to their minimal delta (frame of reference).
+ *  \details   The block stores a base value, the minimal delta and the number of bits of the largest offset of a delta to the minimum. Each offset
+ *             is stored with this number of bits. The offsets are distributed round robin over lanes, each lane is packed into 32 bit words
+ *             and the words of the lanes are interleaved. So the k-th words of all lanes are adjacent in memory and a block is unpacked with
+ *             one vector shift and mask per group of lanes values. A block with less than block_size rows is packed with offsets of zero behind
+ *             its last row.
+ */
+class FrameOfReferenceBlock{
+	public:
+	/*! \brief maximal number of rows per block*/
+	static const size_t block_size=128;
+	/*! \brief number of interleaved lanes, one AVX2 register or two SSE registers of 32 bit values*/
+	static const size_t lanes=8;
+	/***************** constructors and destructor *****************/
+	FrameOfReferenceBlock();
+
+	size_t size() const throw();
+	void encode(const int* values, size_t number_of_values);
+	int get(size_t index) const;
+	/*! \brief decodes all block_size rows into values, the values behind the last row of a block with less rows are garbage*/
+	void decode(int* values) const;
+	size_t getSizeinBytes() const throw();
+	void swap(FrameOfReferenceBlock& block);
+
+	/*! \brief returns the number of 32 bit words of a block with bits bits per offset*/
+	static size_t wordsPerBlock(unsigned int bits);
+	/*! \brief packs the block_size offsets with bits bits each into words, which has to be zero initialized*/
+	static void pack(const boost::uint32_t* offsets, unsigned int bits, boost::uint32_t* words);
+	/*! \brief unpacks the block_size offsets of a block with bits bits per offset, uses the widest vector instructions of the CPU*/
+	static void unpack(const boost::uint32_t* words, unsigned int bits, boost::uint32_t* offsets);
+	/*! \brief computes the values of a block, the i-th value is base plus the inclusive prefix sum of min_delta plus offsets
+	 *  \details uses the widest vector instructions of the CPU, all sums are computed modulo 2^32*/
+	static void prefixSum(const boost::uint32_t* offsets, boost::uint32_t min_delta, boost::uint32_t base, int* values);
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & words_;
+		ar & base_;
+		ar & min_delta_;
+		ar & bits_;
+		ar & number_of_rows_;
+	}
+
+	std::vector<boost::uint32_t> words_;
+	/*! value of the first row minus the minimal delta, the first row is encoded as delta zero*/
+	boost::int32_t base_;
+	boost::int32_t min_delta_;
+	/*! number of bits per offset*/
+	boost::uint8_t bits_;
+	boost::uint16_t number_of_rows_;
+};
+
+/*! \brief the codec of integer columns with fixed length deltas*/
+typedef BlockedDeltaCodec<int,FrameOfReferenceBlock> FrameOfReferenceDeltaCodec;
+
+/***************** Start of Implementation Section ******************/
+
+	/*! \brief returns a mask of the lowest bits bits*/
+	inline boost::uint32_t low_bits_mask(unsigned int bits){
+		return bits>=32 ? ~boost::uint32_t(0) : (boost::uint32_t(1) << bits)-1;
+	}
+
+	/*! \brief unpacks the offsets with plain integer instructions*/
+	inline void unpack_block_scalar(const boost::uint32_t* words, unsigned int bits, boost::uint32_t* offsets){
+		const size_t lanes = FrameOfReferenceBlock::lanes;
+		const boost::uint32_t mask = low_bits_mask(bits);
+		for(size_t i=0;i<FrameOfReferenceBlock::block_size;i++){
+			const size_t lane = i%lanes;
+			const unsigned int bit = unsigned(i/lanes)*bits;
+			const unsigned int word = bit >> 5;
+			const unsigned int shift = bit & 31;
+			boost::uint32_t offset = words[word*lanes+lane] >> shift;
+			if(shift+bits>32){
+				offset |= words[(word+1)*lanes+lane] << (32-shift);
+			}
+			offsets[i] = offset & mask;
+		}
+	}
+
+#if defined(COGADB_RUNTIME_AVX2) || defined(__SSE2__)
+	/*! \brief unpacks the offsets of four lanes at once*/
+	inline void unpack_block_sse2(const boost::uint32_t* words, unsigned int bits, boost::uint32_t* offsets){
+		const size_t lanes = FrameOfReferenceBlock::lanes;
+		const __m128i mask = _mm_set1_epi32(int(low_bits_mask(bits)));
+		for(size_t value=0;value<FrameOfReferenceBlock::block_size/lanes;value++){
+			const unsigned int bit = unsigned(value)*bits;
+			const unsigned int word = bit >> 5;
+			const __m128i shift = _mm_cvtsi32_si128(int(bit & 31));
+			const bool spans_words = (bit & 31)+bits>32;
+			const __m128i remaining_shift = _mm_cvtsi32_si128(int(32-(bit & 31)));
+			for(size_t lane=0;lane<lanes;lane+=4){
+				__m128i result = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words+word*lanes+lane)),shift);
+				if(spans_words){
+					result = _mm_or_si128(result,_mm_sll_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words+(word+1)*lanes+lane)),remaining_shift));
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(offsets+value*lanes+lane),_mm_and_si128(result,mask));
+			}
+		}
+	}
+#endif
+
+#ifdef COGADB_RUNTIME_AVX2
+	/*! \brief unpacks the offsets of all eight lanes at once, compiled for AVX2 independent of the compiler flags*/
+	__attribute__((target("avx2")))
+	inline void unpack_block_avx2(const boost::uint32_t* words, unsigned int bits, boost::uint32_t* offsets){
+		const size_t lanes = FrameOfReferenceBlock::lanes;
+		const __m256i mask = _mm256_set1_epi32(int(low_bits_mask(bits)));
+		for(size_t value=0;value<FrameOfReferenceBlock::block_size/lanes;value++){
+			const unsigned int bit = unsigned(value)*bits;
+			const unsigned int word = bit >> 5;
+			__m256i result = _mm256_srl_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words+word*lanes)),_mm_cvtsi32_si128(int(bit & 31)));
+			if((bit & 31)+bits>32){
+				result = _mm256_or_si256(result,_mm256_sll_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words+(word+1)*lanes)),_mm_cvtsi32_si128(int(32-(bit & 31)))));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(offsets+value*lanes),_mm256_and_si256(result,mask));
+		}
+	}
+#endif
+
+	/*! \brief computes the prefix sums of a block sequentially*/
+	inline void prefix_sum_block_scalar(const boost::uint32_t* offsets, boost::uint32_t min_delta, boost::uint32_t base, int* values){
+		boost::uint32_t value = base;
+		for(size_t i=0;i<FrameOfReferenceBlock::block_size;i++){
+			value += min_delta+offsets[i];
+			values[i] = int(value);
+		}
+	}
+
+#if defined(COGADB_RUNTIME_AVX2) || defined(__SSE2__)
+	/*! \brief computes the prefix sums of four values with two shifted additions and adds the sum of all previous values*/
+	inline void prefix_sum_block_sse2(const boost::uint32_t* offsets, boost::uint32_t min_delta, boost::uint32_t base, int* values){
+		const __m128i min = _mm_set1_epi32(int(min_delta));
+		__m128i carry = _mm_set1_epi32(int(base));
+		for(size_t i=0;i<FrameOfReferenceBlock::block_size;i+=4){
+			__m128i sums = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets+i)),min);
+			sums = _mm_add_epi32(sums,_mm_slli_si128(sums,4));
+			sums = _mm_add_epi32(sums,_mm_slli_si128(sums,8));
+			sums = _mm_add_epi32(sums,carry);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values+i),sums);
+			carry = _mm_shuffle_epi32(sums,_MM_SHUFFLE(3,3,3,3));
+		}
+	}
+#endif
+
+#ifdef COGADB_RUNTIME_AVX2
+	/*! \brief computes the prefix sums of eight values, the shifts work on the two halves, so the sum of the lower half is added to the upper half*/
+	__attribute__((target("avx2")))
+	inline void prefix_sum_block_avx2(const boost::uint32_t* offsets, boost::uint32_t min_delta, boost::uint32_t base, int* values){
+		const __m256i min = _mm256_set1_epi32(int(min_delta));
+		const __m256i last = _mm256_set1_epi32(7);
+		__m256i carry = _mm256_set1_epi32(int(base));
+		for(size_t i=0;i<FrameOfReferenceBlock::block_size;i+=8){
+			__m256i sums = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets+i)),min);
+			sums = _mm256_add_epi32(sums,_mm256_slli_si256(sums,4));
+			sums = _mm256_add_epi32(sums,_mm256_slli_si256(sums,8));
+			const __m256i lower_sum = _mm256_shuffle_epi32(sums,_MM_SHUFFLE(3,3,3,3));
+			sums = _mm256_add_epi32(sums,_mm256_permute2x128_si256(lower_sum,lower_sum,0x08));
+			sums = _mm256_add_epi32(sums,carry);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(values+i),sums);
+			carry = _mm256_permutevar8x32_epi32(sums,last);
+		}
+	}
+#endif
+
+	typedef void (*PrefixSumBlockFunction)(const boost::uint32_t*, boost::uint32_t, boost::uint32_t, int*);
+
+	/*! \brief returns the prefix sum kernel for the widest vector instructions the CPU supports*/
+	inline PrefixSumBlockFunction select_prefix_sum_block_function(){
+#ifdef COGADB_RUNTIME_AVX2
+		if(__builtin_cpu_supports("avx2")) return &prefix_sum_block_avx2;
+		return &prefix_sum_block_sse2;
+#elif defined(__SSE2__)
+		return &prefix_sum_block_sse2;
+#endif
+		return &prefix_sum_block_scalar;
+	}
+
+	typedef void (*UnpackBlockFunction)(const boost::uint32_t*, unsigned int, boost::uint32_t*);
+
+	/*! \brief returns the unpack kernel for the widest vector instructions the CPU supports*/
+	inline UnpackBlockFunction select_unpack_block_function(){
+#ifdef COGADB_RUNTIME_AVX2
+		if(__builtin_cpu_supports("avx2")) return &unpack_block_avx2;
+		return &unpack_block_sse2;
+#elif defined(__SSE2__)
+		return &unpack_block_sse2;
+#endif
+		return &unpack_block_scalar;
+	}
+
+	inline FrameOfReferenceBlock::FrameOfReferenceBlock() : words_(), base_(0), min_delta_(0), bits_(0), number_of_rows_(0){
+
+	}
+
+	inline size_t FrameOfReferenceBlock::size() const throw(){
+		return number_of_rows_;
+	}
+
+	inline void FrameOfReferenceBlock::encode(const int* values, size_t number_of_values){
+		number_of_rows_ = boost::uint16_t(number_of_values);
+		if(number_of_values==0){
+			std::vector<boost::uint32_t>().swap(words_);
+			return;
+		}
+		//the deltas are computed modulo 2^32, so no difference of two integers overflows
+		boost::uint32_t deltas[block_size];
+		min_delta_ = 0;
+		for(size_t i=1;i<number_of_values;i++){
+			deltas[i] = boost::uint32_t(values[i])-boost::uint32_t(values[i-1]);
+			if(i==1 || boost::int32_t(deltas[i])<min_delta_) min_delta_=boost::int32_t(deltas[i]);
+		}
+		boost::uint32_t max_offset = 0;
+		//the first row is encoded as the minimal delta, so its offset is zero
+		deltas[0]=boost::uint32_t(min_delta_);
+		for(size_t i=0;i<number_of_values;i++){
+			deltas[i] -= boost::uint32_t(min_delta_);
+			max_offset = std::max(max_offset,deltas[i]);
+		}
+		std::fill(deltas+number_of_values,deltas+block_size,0);
+		bits_ = 0;
+		while(bits_<32 && (max_offset >> bits_)!=0) bits_++;
+
+		base_ = boost::int32_t(boost::uint32_t(values[0])-boost::uint32_t(min_delta_));
+		std::vector<boost::uint32_t> words(wordsPerBlock(bits_),0);
+		if(!words.empty()) pack(deltas,bits_,&words[0]);
+		words_.swap(words);
+	}
+
+	inline int FrameOfReferenceBlock::get(size_t index) const{
+		int values[block_size];
+		decode(values);
+		return values[index];
+	}
+
+	inline void FrameOfReferenceBlock::decode(int* values) const{
+		if(number_of_rows_==0) return;
+		boost::uint32_t offsets[block_size];
+		unpack(words_.empty() ? 0 : &words_[0],bits_,offsets);
+		prefixSum(offsets,boost::uint32_t(min_delta_),boost::uint32_t(base_),values);
+	}
+
+	inline size_t FrameOfReferenceBlock::getSizeinBytes() const throw(){
+		return words_.capacity()*sizeof(boost::uint32_t);
+	}
+
+	inline void FrameOfReferenceBlock::swap(FrameOfReferenceBlock& block){
+		words_.swap(block.words_);
+		std::swap(base_,block.base_);
+		std::swap(min_delta_,block.min_delta_);
+		std::swap(bits_,block.bits_);
+		std::swap(number_of_rows_,block.number_of_rows_);
+	}
+
+	inline size_t FrameOfReferenceBlock::wordsPerBlock(unsigned int bits){
+		return lanes*((block_size/lanes*bits+31)/32);
+	}
+
+	inline void FrameOfReferenceBlock::pack(const boost::uint32_t* offsets, unsigned int bits, boost::uint32_t* words){
+		if(bits==0) return;
+		for(size_t i=0;i<block_size;i++){
+			const size_t lane = i%lanes;
+			const unsigned int bit = unsigned(i/lanes)*bits;
+			const unsigned int word = bit >> 5;
+			const unsigned int shift = bit & 31;
+			words[word*lanes+lane] |= offsets[i] << shift;
+			if(shift+bits>32){
+				words[(word+1)*lanes+lane] |= offsets[i] >> (32-shift);
+			}
+		}
+	}
+
+	inline void FrameOfReferenceBlock::unpack(const boost::uint32_t* words, unsigned int bits, boost::uint32_t* offsets){
+		if(bits==0){
+			std::fill(offsets,offsets+block_size,0);
+			return;
+		}
+		static const UnpackBlockFunction unpack_block = select_unpack_block_function();
+		unpack_block(words,bits,offsets);
+	}
+
+	inline void FrameOfReferenceBlock::prefixSum(const boost::uint32_t* offsets, boost::uint32_t min_delta, boost::uint32_t base, int* values){
+		static const PrefixSumBlockFunction prefix_sum_block = select_prefix_sum_block_function();
+		prefix_sum_block(offsets,min_delta,base,values);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
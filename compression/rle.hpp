@@ -5,18 +5,32 @@
 #include <string>
 #include <map>
 #include <iostream>
+#include <fstream>
 #include <iterator>
 #include <vector>
 #include <algorithm>
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <core/position_interval_list.hpp>
+#include <compression/run_tree.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace CoGaDB{
 	
 
 /*!
- *  \brief     This class represents a dictionary compressed column with type T, is the base class for all compressed typed column classes.
+ *  \brief     This class represents a run length encoded column with type T, which stores every run of equal values once.
+ *  \details   The runs are kept in a balanced tree, so the run of a row is found and a row is updated or deleted in O(log runs).
+ *             The run of the last access is cached, so sequential accesses to the rows of a run need constant time.
  */	
 template<class T>
 class rleCompressedColumn : public CompressedColumn<T>{
@@ -26,16 +40,28 @@ class rleCompressedColumn : public CompressedColumn<T>{
 	virtual ~rleCompressedColumn();
 
 	virtual bool insert(const boost::any& new_Value);
+	/*! \brief appends new_value in amortized constant time, it extends the last run if it has the same value
+	 *  \details the first insert after an update or delete costs O(log runs) once*/
 	virtual bool insert(const T& new_value);
+	/*! \brief appends the values in [first,last), uses all hardware threads to find the runs of a large input*/
 	template <typename InputIterator>
 	bool insert(InputIterator first, InputIterator last);
+	/*! \brief appends the values in [first,last), every run of equal values in the input is appended at once
+	 *  \details Input with random access is split into parts, whose runs are found by number_of_threads threads. A run that spans
+	 *  the border of two parts is stitched together when the parts are appended. Other input is encoded in a single pass.*/
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last, unsigned int number_of_threads);
 
 	virtual bool update(TID tid, const boost::any& new_value);
 	virtual bool update(PositionListPtr tid, const boost::any& new_value);	
+	/*! \brief replaces the rows of every interval by a single run*/
+	virtual bool update(PositionIntervalListPtr tids, const boost::any& new_value);
 	
 	virtual bool remove(TID tid);
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid);
+	/*! \brief deletes the runs covered by every interval at once*/
+	virtual bool remove(PositionIntervalListPtr tids);
 	virtual bool clearContent();
 
 	virtual const boost::any get(TID tid);
@@ -49,29 +75,138 @@ class rleCompressedColumn : public CompressedColumn<T>{
 	virtual bool store(const std::string& path);
 	virtual bool load(const std::string& path);
 
-
+	/***************** relational operations evaluated on the runs *****************/
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief compares the value of every run once and returns the tids of the matching runs as intervals*/
+	const PositionIntervalListPtr interval_selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	/*! \brief joins run by run and expands the blocks of interval_hash_join into pairs of tids*/
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column);
+	/*! \brief builds a hash table with one entry per run, every match of a run with rows of join_column yields one block of the result
+	 *  \details consecutive rows of join_column with equal values are probed once, a run length encoded join_column is read run by run,
+	 *  so the join scales with the number of runs. The first interval of a block refers to this column.*/
+	const TIDIntervalPairListPtr interval_hash_join(ColumnPtr join_column);
+	using ColumnBaseTyped<T>::aggregate;
+	/*! \brief aggregates every run in [begin,end) at once, a sum multiplies the value of a run with its length*/
+	virtual T aggregate(AggregationMethod agg_meth, TID begin, TID end);
+	/*! \brief aggregates the positions in tids, consecutive positions in the same run are aggregated at once*/
+	virtual T aggregate(AggregationMethod agg_meth, PositionListPtr tids);
+	/*! \brief aggregates the positions in the intervals, e.g., the result of interval_selection, in O(runs)*/
+	T aggregate(AggregationMethod agg_meth, const PositionIntervalList& tids);
 	
-	virtual T& operator[](const int indxex);
-	std::vector<T>& getContent();
+	virtual T& operator[](const int index);
+	/*! \brief fills values run by run*/
+	virtual void getValues(TID begin, size_t number_of_values, T* values);
+	RunTree<T>& getContent();
+
+	/*! \brief forward cursor that keeps its current run, so moving to the next row or the next run costs amortized constant time
+	 *  \details The column must not be modified while a cursor is in use.*/
+	class RunCursor{
+		public:
+		explicit RunCursor(const rleCompressedColumn<T>& column, TID begin=0);
+		/*! \brief returns false, if the cursor moved behind the last row*/
+		inline bool valid() const throw();
+		inline const T& value() const throw();
+		inline TID getTID() const throw();
+		/*! \brief returns the position behind the last row of the current run*/
+		inline TID getRunEnd() const throw();
+		inline void next();
+		/*! \brief moves to the first row of the next run*/
+		inline void nextRun();
+		private:
+		typename RunTree<T>::Cursor run_;
+		TID position_;
+	};
 
 	private:
+	/*! \brief 64 bit row positions, so that the index does not overflow on large columns*/
+	typedef boost::uint64_t Position;
+	typedef boost::unordered_multimap<T,TIDInterval,boost::hash<T>, std::equal_to<T> > RunHashTable;
+	/*! \brief appends a block for every run in hashtable with the same value as the rows*/
+	static void probeRuns(const RunHashTable& hashtable, const T& value, const TIDInterval& rows, TIDIntervalPairList& blocks);
+	/*! \brief the runs of a part of a bulk insert, which are found by one thread*/
+	struct LocalRuns{
+		LocalRuns() : values(), lengths(){}
+		std::vector<T> values;
+		std::vector<Position> lengths;
+	};
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last, unsigned int number_of_threads, std::input_iterator_tag);
+	template <typename RandomAccessIterator>
+	bool insert(RandomAccessIterator first, RandomAccessIterator last, unsigned int number_of_threads, std::random_access_iterator_tag);
+	/*! \brief finds the runs in [first,last)*/
+	template <typename RandomAccessIterator>
+	static void findRuns(RandomAccessIterator first, RandomAccessIterator last, LocalRuns* runs);
+	/*! \brief appends number_of_rows rows of value behind the last row*/
+	inline void append(const T& value, Position number_of_rows);
+	/*! \brief returns the value of the row on position, first checks the cached run*/
+	const T& find(Position position) const;
+	/*! \brief replaces the rows [begin,end) by a single run of value*/
+	void assignRange(Position begin, Position end, const T& value);
+	/*! \brief deletes the rows [begin,end)*/
+	void eraseRange(Position begin, Position end);
+	/*! \brief adds number_of_rows rows of value to the aggregate result, found is false as long as result holds no value*/
+	static void aggregateRun(const T& value, Position number_of_rows, AggregationMethod agg_meth, T& result, bool& found);
+	/*! \brief adds the rows [begin,end) to the aggregate result*/
+	void aggregateRange(Position begin, Position end, AggregationMethod agg_meth, T& result, bool& found) const;
 
 		struct Type_TID_Comparator {
   			inline bool operator() (std::pair<T,TID> i, std::pair<T,TID> j) { return (i.first<j.first);}
 		} type_tid_comparator;
 
 
-	std::vector<T> values_;
-    std::vector<int> run_;
-    int i;
+	/*! the runs ordered by their positions*/
+	RunTree<T> runs_;
+	/*! rows [last_run_begin_,last_run_end_) of the run of the last access have the value last_run_value_, speeds up sequential access*/
+	mutable Position last_run_begin_;
+	mutable Position last_run_end_;
+	mutable T last_run_value_;
+	/*! value returned by operator[]*/
+	T key_;
 
 };
 
 /***************** Start of Implementation Section ******************/
 
+	/*! \brief returns the first position in (first,last) whose value differs from the value on first, or last*/
+	template <typename RandomAccessIterator>
+	inline RandomAccessIterator find_run_end(RandomAccessIterator first, RandomAccessIterator last){
+		RandomAccessIterator it = first;
+		for(++it;it!=last && *it==*first;++it){}
+		return it;
+	}
+
+#ifdef __SSE2__
+	/*! \brief compares four neighbouring values at once with the value of the run*/
+	inline const int* find_run_end(const int* first, const int* last){
+		const __m128i value = _mm_set1_epi32(*first);
+		const int* it = first+1;
+		for(;last-it>=4;it+=4){
+			int equal = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it)),value));
+			if(equal!=0xFFFF){
+				return it+(__builtin_ctz(~equal)>>2);
+			}
+		}
+		for(;it!=last && *it==*first;++it){}
+		return it;
+	}
+
+	inline const float* find_run_end(const float* first, const float* last){
+		const __m128 value = _mm_set1_ps(*first);
+		const float* it = first+1;
+		for(;last-it>=4;it+=4){
+			int equal = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(it),value));
+			if(equal!=0xF){
+				return it+__builtin_ctz(~equal);
+			}
+		}
+		for(;it!=last && *it==*first;++it){}
+		return it;
+	}
+#endif
+
 	
 	template<class T>
-	rleCompressedColumn<T>::rleCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type), type_tid_comparator(), values_(), run_(), i(){
+	rleCompressedColumn<T>::rleCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type), type_tid_comparator(), runs_(), last_run_begin_(0), last_run_end_(0), last_run_value_(), key_(){
 
 	}
 
@@ -81,8 +216,8 @@ class rleCompressedColumn : public CompressedColumn<T>{
 	}
 
 	template<class T>
-	std::vector<T>& rleCompressedColumn<T>::getContent(){
-		return values_;
+	RunTree<T>& rleCompressedColumn<T>::getContent(){
+		return runs_;
 	}
 
 	template<class T>
@@ -90,54 +225,169 @@ class rleCompressedColumn : public CompressedColumn<T>{
 		if(new_value.empty()) return false;
 		if(typeid(T)==new_value.type()){
 			 T value = boost::any_cast<T>(new_value);
-			 values_.push_back(value);
-			 return true;
+			 return insert(value);
 		}
 		return false;
 	}
 
 
+	template<class T>
+	inline void rleCompressedColumn<T>::append(const T& value, Position number_of_rows){
+		//appending does not change the cached run, at most it becomes longer
+		runs_.append(value,number_of_rows);
+	}
+
 	template<class T>
 	bool rleCompressedColumn<T>::insert(const T& new_value){
-	 	typename std::vector<T>::size_type sz = values_.size();
+		append(new_value,1);
+	    return true;
+	}
 
-		if(sz == 0){
-			values_.push_back(new_value);
-			run_.push_back(1);
-		}
-		else{
-		if(values_[sz-1] != new_value) {
-			values_.insert(values_.begin()+sz,new_value);
-			run_.insert(run_.begin()+sz,1);
-			//std::cout << values_[sz]; 
+	template<class T>
+	const T& rleCompressedColumn<T>::find(Position position) const{
+		if(position<last_run_begin_ || position>=last_run_end_){
+			typename RunTree<T>::Cursor run = runs_.find(position);
+			last_run_begin_=run.getRunBegin();
+			last_run_end_=run.getRunEnd();
+			last_run_value_=run.value();
 		}
-		else{ 
-			int n = sz-1;
-			run_.insert(run_.begin()+n,1);}
+		return last_run_value_;
+	}
+
+	template<class T>
+	T& rleCompressedColumn<T>::operator[](const int index){
+		//we return a copy, so that writes through the reference cannot change a whole run
+		key_ = find(Position(unsigned(index)));
+		return key_;
+	}
+
+	template<class T>
+	void rleCompressedColumn<T>::getValues(TID begin, size_t number_of_values, T* values){
+		for(RunCursor cursor(*this,begin);number_of_values>0;cursor.nextRun()){
+			const size_t number_of_rows = std::min<size_t>(number_of_values,cursor.getRunEnd()-cursor.getTID());
+			std::fill(values,values+number_of_rows,cursor.value());
+			values+=number_of_rows;
+			number_of_values-=number_of_rows;
 		}
-	    return true;
 	}
 
 	template<class T>
-	T& rleCompressedColumn<T>::operator[](const int indxex){
-		short unsigned int indx=0,i;
-		for(i=0;indx<indxex;i++){
-			indx +=run_.at(i);
+	rleCompressedColumn<T>::RunCursor::RunCursor(const rleCompressedColumn<T>& column, TID begin) : run_(column.runs_.find(begin)), position_(begin){
+
+	}
+
+	template<class T>
+	inline bool rleCompressedColumn<T>::RunCursor::valid() const throw(){
+		return run_.valid();
+	}
+
+	template<class T>
+	inline const T& rleCompressedColumn<T>::RunCursor::value() const throw(){
+		return run_.value();
+	}
+
+	template<class T>
+	inline TID rleCompressedColumn<T>::RunCursor::getTID() const throw(){
+		return position_;
+	}
+
+	template<class T>
+	inline TID rleCompressedColumn<T>::RunCursor::getRunEnd() const throw(){
+		return TID(run_.getRunEnd());
+	}
+
+	template<class T>
+	inline void rleCompressedColumn<T>::RunCursor::next(){
+		if(++position_==run_.getRunEnd()){
+			run_.next();
 		}
-		return values_.at(i);
+	}
+
+	template<class T>
+	inline void rleCompressedColumn<T>::RunCursor::nextRun(){
+		position_=getRunEnd();
+		run_.next();
 	}
 
 	template <typename T> 
 	template <typename InputIterator>
 	bool rleCompressedColumn<T>::insert(InputIterator first , InputIterator last){
-		this->values_.insert(this->values_.end(),first,last);
+		return insert(first,last,std::max(1u,boost::thread::hardware_concurrency()));
+	}
+
+	template <typename T> 
+	template <typename InputIterator>
+	bool rleCompressedColumn<T>::insert(InputIterator first , InputIterator last, unsigned int number_of_threads){
+		return insert(first,last,number_of_threads,typename std::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	template <typename T> 
+	template <typename RandomAccessIterator>
+	void rleCompressedColumn<T>::findRuns(RandomAccessIterator first, RandomAccessIterator last, LocalRuns* runs){
+		while(first!=last){
+			RandomAccessIterator run_end = find_run_end(first,last);
+			runs->values.push_back(*first);
+			runs->lengths.push_back(Position(run_end-first));
+			first=run_end;
+		}
+	}
+
+	template <typename T> 
+	template <typename RandomAccessIterator>
+	bool rleCompressedColumn<T>::insert(RandomAccessIterator first , RandomAccessIterator last, unsigned int number_of_threads, std::random_access_iterator_tag){
+		const size_t number_of_values = last-first;
+		//small inputs are not worth the threads
+		const size_t min_values_per_thread = 64*1024;
+		number_of_threads = std::max<size_t>(1,std::min<size_t>(number_of_threads,number_of_values/min_values_per_thread));
+		const size_t values_per_thread = (number_of_values+number_of_threads-1)/number_of_threads;
+		//the values of a vector are contiguous, so the runs can be found with vector instructions on plain pointers
+		const bool contiguous = boost::is_pointer<RandomAccessIterator>::value
+			|| boost::is_same<RandomAccessIterator,typename std::vector<T>::iterator>::value
+			|| boost::is_same<RandomAccessIterator,typename std::vector<T>::const_iterator>::value;
+
+		std::vector<LocalRuns> local_runs(number_of_threads);
+		boost::thread_group threads;
+		for(unsigned int t=0;t<number_of_threads;t++){
+			const size_t begin = std::min(number_of_values,t*values_per_thread);
+			const size_t end = std::min(number_of_values,begin+values_per_thread);
+			if(contiguous && begin<end){
+				const T* values = &*first;
+				threads.create_thread(boost::bind(&rleCompressedColumn<T>::template findRuns<const T*>,values+begin,values+end,&local_runs[t]));
+			}else{
+				threads.create_thread(boost::bind(&rleCompressedColumn<T>::template findRuns<RandomAccessIterator>,first+begin,first+end,&local_runs[t]));
+			}
+		}
+		threads.join_all();
+
+		//append merges the first run of a part with the last run of its predecessor, if they have the same value
+		for(unsigned int t=0;t<number_of_threads;t++){
+			for(size_t run=0;run<local_runs[t].values.size();run++){
+				append(local_runs[t].values[run],local_runs[t].lengths[run]);
+			}
+		}
+		return true;
+	}
+
+	template <typename T> 
+	template <typename InputIterator>
+	bool rleCompressedColumn<T>::insert(InputIterator first , InputIterator last, unsigned int, std::input_iterator_tag){
+		//a single pass, because an input iterator can only be read once
+		while(first!=last){
+			//the value is copied, because an input iterator may only be dereferenced once per position
+			const T value = *first;
+			Position number_of_rows=1;
+			for(++first;first!=last && *first==value;++first){
+				number_of_rows++;
+			}
+			append(value,number_of_rows);
+		}
 		return true;
 	}
 
 	template<class T>
 	const boost::any rleCompressedColumn<T>::get(TID tid){
-				if(tid<values_.size())
- 			return boost::any(values_[tid]);
+				if(tid<size())
+ 			return boost::any(find(tid));
 		else{
 			std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid  << std::endl;
 		}
@@ -149,45 +399,50 @@ class rleCompressedColumn : public CompressedColumn<T>{
 	void rleCompressedColumn<T>::print() const throw(){
 		std::cout << "| " << this->name_ << " |" << std::endl;
 		std::cout << "________________________" << std::endl;
-		for(unsigned int i=0;i<values_.size();i++){
-			std::cout << "| " << values_[i] << " |" << std::endl;
+		for(typename RunTree<T>::Cursor run=runs_.begin();run.valid();run.next()){
+			for(Position i=run.getRunBegin();i<run.getRunEnd();i++){
+				std::cout << "| " << run.value() << " |" << std::endl;
+			}
 		}
 	}
 	template<class T>
 	size_t rleCompressedColumn<T>::size() const throw(){
-		return values_.size();
+		return size_t(runs_.size());
 	}
 	template<class T>
 	const ColumnPtr rleCompressedColumn<T>::copy() const{
 		return ColumnPtr(new rleCompressedColumn<T>(*this));
 	}
 
+	template<class T>
+	void rleCompressedColumn<T>::assignRange(Position begin, Position end, const T& value){
+		runs_.assign(begin,end,value);
+		last_run_end_=0;
+	}
+
+	template<class T>
+	void rleCompressedColumn<T>::eraseRange(Position begin, Position end){
+		runs_.erase(begin,end);
+		last_run_end_=0;
+	}
+
 	template<class T>
 	bool rleCompressedColumn<T>::update(TID tid, const boost::any& new_value ){
-		unsigned int i,indx=0;
+		if(new_value.empty() || typeid(T)!=new_value.type()) return false;
+		if(tid>=size()) return false;
 		T value = boost::any_cast<T>(new_value);
-		for(i=0;indx<tid;i++){
-			indx +=run_.at(i);
-		}
-		if(run_.at(i)==1)
-			values_.at(i) = value;
-		else{
-			
-			if(indx==tid)
-			{
-				run_.at(i)--;
-				values_.insert(values_.begin()+i,value);
-				run_.insert(run_.begin()+i,1);	
-			}			
-			else{
-				int diff = indx-tid;
-				run_.at(i) = diff-1;
-				values_.insert(values_.begin()+i+1,value);
-				run_.insert(run_.begin()+i+1,1);
-				values_.insert(values_.begin()+i+2,values_.at(i));
-				run_.insert(run_.begin()+i+2,diff);
-						
-			}
+		if(find(tid)==value) return true;
+		assignRange(tid,Position(tid)+1,value);
+		return true;
+	}
+
+	template<class T>
+	bool rleCompressedColumn<T>::update(PositionIntervalListPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		if(new_value.empty() || typeid(T)!=new_value.type()) return false;
+		T value = boost::any_cast<T>(new_value);
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			assignRange(it->first,it->second,value);
 		}
 		return true;
 	}
@@ -198,10 +453,8 @@ class rleCompressedColumn : public CompressedColumn<T>{
 			return false;
 	    if(new_value.empty()) return false;
 		    if(typeid(T)==new_value.type()){
-			 T value = boost::any_cast<T>(new_value);
 			 for(unsigned int i=0;i<tids->size();i++){
-				TID tid=(*tids)[i];
-				values_[tid]=value;
+				update((*tids)[i],new_value);
 			}
 			 return true;
 		}else{
@@ -212,18 +465,20 @@ class rleCompressedColumn : public CompressedColumn<T>{
 	
 	template<class T>
 	bool rleCompressedColumn<T>::remove(TID tid){
-		unsigned int i,indx=0;
-		for(i=0;indx<tid;i++){
-			indx +=run_.at(i);
-		}
-		if(run_.at(i)==1){
-			run_.erase(run_.begin()+i);
-			values_.erase(values_.begin()+i);	
-		}
-		else{
-			run_.at(i)--;
+		if(tid>=size()) return false;
+		eraseRange(tid,Position(tid)+1);
+		return true;	
+	}
+
+	template<class T>
+	bool rleCompressedColumn<T>::remove(PositionIntervalListPtr tids){
+		if(!tids) return false;
+		if(tids->empty()) return false;
+		//removing from the back keeps the tids in front valid
+		for(PositionIntervalList::const_reverse_iterator it=tids->rbegin();it!=tids->rend();++it){
+			eraseRange(it->first,it->second);
 		}
-	return true;	
+		return true;
 	}
 	
 	template<class T>
@@ -237,16 +492,166 @@ class rleCompressedColumn : public CompressedColumn<T>{
 		typename PositionList::reverse_iterator rit;
 
 		for (rit = tids->rbegin(); rit!=tids->rend(); ++rit)
-			values_.erase(values_.begin()+(*rit));
+			if(!remove(*rit)) return false;
 		return true;			
 	}
 
 	template<class T>
 	bool rleCompressedColumn<T>::clearContent(){
-		values_.clear();
+		runs_.clear();
+		last_run_end_=0;
 		return true;
 	}
 
+	template<class T>
+	const PositionListPtr rleCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return interval_selection(value_for_comparison,comp)->toPositionList();
+	}
+
+	template<class T>
+	const PositionIntervalListPtr rleCompressedColumn<T>::interval_selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		if(value_for_comparison.type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		T value = boost::any_cast<T>(value_for_comparison);
+		PositionIntervalListPtr result_tids( new PositionIntervalList());
+		for(typename RunTree<T>::Cursor run=runs_.begin();run.valid();run.next()){
+			bool match=false;
+			if(comp==EQUAL){
+				match = (value==run.value());
+			}else if(comp==LESSER){
+				match = (run.value()<value);
+			}else if(comp==GREATER){
+				match = (run.value()>value);
+			}
+			if(match){
+				result_tids->push_back(TID(run.getRunBegin()),TID(run.getRunEnd()));
+			}
+		}
+		return result_tids;
+	}
+
+	template<class T>
+	const PositionListPairPtr rleCompressedColumn<T>::hash_join(ColumnPtr join_column){
+		return toPositionListPair(*interval_hash_join(join_column));
+	}
+
+	template<class T>
+	const TIDIntervalPairListPtr rleCompressedColumn<T>::interval_hash_join(ColumnPtr join_column_){
+		if(join_column_->type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+		RunHashTable hashtable;
+		for(typename RunTree<T>::Cursor run=runs_.begin();run.valid();run.next()){
+			hashtable.insert(std::make_pair(run.value(),TIDInterval(TID(run.getRunBegin()),TID(run.getRunEnd()))));
+		}
+
+		TIDIntervalPairListPtr blocks( new TIDIntervalPairList());
+		shared_pointer_namespace::shared_ptr<rleCompressedColumn<T> > rle_column = shared_pointer_namespace::dynamic_pointer_cast<rleCompressedColumn<T> >(join_column_);
+		if(rle_column){
+			for(RunCursor cursor(*rle_column);cursor.valid();cursor.nextRun()){
+				probeRuns(hashtable,cursor.value(),TIDInterval(cursor.getTID(),cursor.getRunEnd()),*blocks);
+			}
+		}else{
+			shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > join_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_);
+			typename ColumnBaseTyped<T>::Cursor cursor(*join_column);
+			while(cursor.valid()){
+				const T value = cursor.value();
+				const TID begin = cursor.getTID();
+				for(cursor.next();cursor.valid() && cursor.value()==value;cursor.next()){}
+				probeRuns(hashtable,value,TIDInterval(begin,cursor.getTID()),*blocks);
+			}
+		}
+		return blocks;
+	}
+
+	template<class T>
+	void rleCompressedColumn<T>::probeRuns(const RunHashTable& hashtable, const T& value, const TIDInterval& rows, TIDIntervalPairList& blocks){
+		std::pair<typename RunHashTable::const_iterator, typename RunHashTable::const_iterator> range = hashtable.equal_range(value);
+		for(typename RunHashTable::const_iterator it=range.first;it!=range.second;++it){
+			blocks.push_back(TIDIntervalPair(it->second,rows));
+		}
+	}
+
+	/*! \brief returns the sum of number_of_rows rows with the same value*/
+	template<class T>
+	inline T sum_of_run(const T& value, boost::uint64_t number_of_rows){
+		return value*T(number_of_rows);
+	}
+
+	template<>
+	inline std::string sum_of_run(const std::string& value, boost::uint64_t){
+		//a sum is undefined on strings, the aggregation methods reject it before they aggregate a run
+		return value;
+	}
+
+	template<class T>
+	void rleCompressedColumn<T>::aggregateRun(const T& value, Position number_of_rows, AggregationMethod agg_meth, T& result, bool& found){
+		if(number_of_rows==0) return;
+		//minimum and maximum only depend on the value of the run
+		const T run_aggregate = (agg_meth==SUM) ? sum_of_run(value,number_of_rows) : value;
+		if(found){
+			aggregate_value(result,run_aggregate,agg_meth);
+		}else{
+			result=run_aggregate;
+			found=true;
+		}
+	}
+
+	template<class T>
+	void rleCompressedColumn<T>::aggregateRange(Position begin, Position end, AggregationMethod agg_meth, T& result, bool& found) const{
+		end = std::min<Position>(end,size());
+		if(begin>=end) return;
+		for(typename RunTree<T>::Cursor run=runs_.find(begin);run.valid() && run.getRunBegin()<end;run.next()){
+			aggregateRun(run.value(),std::min(end,run.getRunEnd())-std::max(begin,run.getRunBegin()),agg_meth,result,found);
+		}
+	}
+
+	template<class T>
+	T rleCompressedColumn<T>::aggregate(AggregationMethod agg_meth, TID begin, TID end){
+		T result = T();
+		if(!check_aggregation_method<T>(agg_meth,this->name_)) return result;
+		bool found=false;
+		aggregateRange(begin,end,agg_meth,result,found);
+		return result;
+	}
+
+	template<class T>
+	T rleCompressedColumn<T>::aggregate(AggregationMethod agg_meth, PositionListPtr tids){
+		T result = T();
+		if(!tids || !check_aggregation_method<T>(agg_meth,this->name_)) return result;
+		bool found=false;
+		size_t i=0;
+		while(i<tids->size()){
+			if((*tids)[i]>=size()){
+				i++;
+				continue;
+			}
+			typename RunTree<T>::Cursor run = runs_.find((*tids)[i]);
+			Position number_of_rows=0;
+			for(;i<tids->size() && run.getRunBegin()<=(*tids)[i] && (*tids)[i]<run.getRunEnd();i++){
+				number_of_rows++;
+			}
+			aggregateRun(run.value(),number_of_rows,agg_meth,result,found);
+		}
+		return result;
+	}
+
+	template<class T>
+	T rleCompressedColumn<T>::aggregate(AggregationMethod agg_meth, const PositionIntervalList& tids){
+		T result = T();
+		if(!check_aggregation_method<T>(agg_meth,this->name_)) return result;
+		bool found=false;
+		for(PositionIntervalList::const_iterator it=tids.begin();it!=tids.end();++it){
+			aggregateRange(it->first,it->second,agg_meth,result,found);
+		}
+		return result;
+	}
+
 	template<class T>
 	bool rleCompressedColumn<T>::store(const std::string& path_){
 		std::string path(path_);
@@ -256,12 +661,21 @@ class rleCompressedColumn : public CompressedColumn<T>{
 		newpath += "newpath";
 		//std::cout << "Writing Column " << this->getName() << " to File " << path << std::endl;
 		std::ofstream outvfile (path.c_str(),std::ios_base::binary | std::ios_base::out);
+		//the file format stores the value and the position behind the last row of every run
+		std::vector<T> values;
+		std::vector<Position> run_ends;
+		values.reserve(runs_.getNumberOfRuns());
+		run_ends.reserve(runs_.getNumberOfRuns());
+		for(typename RunTree<T>::Cursor run=runs_.begin();run.valid();run.next()){
+			values.push_back(run.value());
+			run_ends.push_back(run.getRunEnd());
+		}
 		boost::archive::binary_oarchive opv(outvfile);
-		opv << values_;
+		opv << values;
 
 		std::ofstream outrfile (newpath.c_str(),std::ios_base::binary | std::ios_base::out);
 		boost::archive::binary_oarchive opr(outrfile);
-		opr <<run_;
+		opr << run_ends;
 
 		outvfile.flush();
 		outvfile.close();
@@ -282,27 +696,33 @@ class rleCompressedColumn : public CompressedColumn<T>{
 		
 		//std::cout << "Opening File '" << path << "'..." << std::endl;
 		std::ifstream invfile (path.c_str(),std::ios_base::binary | std::ios_base::in);
+		std::vector<T> values;
+		std::vector<Position> run_ends;
 		boost::archive::binary_iarchive ipv(invfile);
-		ipv >> values_;
+		ipv >> values;
 
 		std::ifstream inrfile (newpath.c_str(),std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ipr(inrfile);
-		ipr >> run_;
+		ipr >> run_ends;
+		clearContent();
+		for(size_t run=0;run<values.size() && run<run_ends.size();run++){
+			append(values[run],run_ends[run]-(run==0 ? 0 : run_ends[run-1]));
+		}
 		invfile.close();
-		inrfile.close();}catch(std::exception e){std::cout<<"error in store";}
+		inrfile.close();}catch(std::exception& e){std::cout<<"error in store";}
 		return true;
 	}
 
 	template<class T>
 	unsigned int rleCompressedColumn<T>::getSizeinBytes() const throw(){
-		return values_.capacity()*sizeof(T);
+		return runs_.getSizeinBytes();
 	}
 
 		template<>
 	inline unsigned int rleCompressedColumn<std::string>::getSizeinBytes() const throw(){
-		unsigned int size_in_bytes=0;
-		for(unsigned int i=0;i<values_.size();++i){
-			size_in_bytes+=values_[i].capacity();
+		size_t size_in_bytes=runs_.getSizeinBytes();
+		for(RunTree<std::string>::Cursor run=runs_.begin();run.valid();run.next()){
+			size_in_bytes+=run.value().capacity();
 		}
 		return size_in_bytes;
 	}
@@ -0,0 +1,473 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This class stores a sequence of runs, i.e. a value and the number of consecutive rows with this value, in a balanced search tree.
+ *  \details   The tree is a treap, which is ordered by the positions of the runs and balanced by random priorities. Every node stores the number
+ *             of rows in its subtree, so the run of a row is found in O(log runs). Ranges of rows are replaced or deleted by splitting the tree
+ *             at the range borders and merging the remaining parts, runs are split at the borders and adjacent runs with equal values are merged.
+ *             The nodes are kept in a vector, so a tree is copied and stored without pointer fixups.
+ *             Runs are appended like in the linear time construction of a cartesian tree: the right spine of the tree is kept on a stack and the row
+ *             counts of its nodes are only completed when a node leaves the spine or before the tree is modified otherwise, so an append
+ *             costs amortized constant time.
+ */
+template<class T>
+class RunTree{
+	public:
+	typedef boost::uint64_t Position;
+	/*! \brief index of a node in the node pool*/
+	typedef boost::uint32_t NodeID;
+
+	/*! \brief forward cursor over the runs of a tree, moving to the next run costs amortized constant time
+	 *  \details the tree must not be modified while a cursor is in use*/
+	class Cursor{
+		public:
+		explicit Cursor(const RunTree<T>& tree);
+		Cursor(const Cursor& cursor);
+		Cursor& operator=(const Cursor& cursor);
+		/*! \brief returns false, if the cursor moved behind the last run*/
+		inline bool valid() const throw();
+		inline const T& value() const throw();
+		/*! \brief returns the position of the first row of the current run*/
+		inline Position getRunBegin() const throw();
+		/*! \brief returns the position behind the last row of the current run*/
+		inline Position getRunEnd() const throw();
+		inline void next();
+		private:
+		friend class RunTree<T>;
+		const RunTree<T>* tree_;
+		/*! ancestors whose run follows the current run*/
+		std::vector<NodeID> ancestors_;
+		NodeID node_;
+		Position run_begin_;
+	};
+
+	/***************** constructors and destructor *****************/
+	RunTree();
+
+	/*! \brief returns the number of rows*/
+	Position size() const throw();
+	size_t getNumberOfRuns() const throw();
+	bool empty() const throw();
+	void clear();
+	/*! \brief returns the value of the row on position*/
+	const T& operator[](Position position) const;
+	/*! \brief returns a cursor on the run that contains position, the cursor is invalid if position lies behind the last row*/
+	Cursor find(Position position) const;
+	/*! \brief returns a cursor on the first run*/
+	Cursor begin() const;
+	/*! \brief appends number_of_rows rows of value in amortized constant time, the last run is extended if it has the same value
+	 *  \details the first append after assign or erase collects the right spine in O(log runs)*/
+	void append(const T& value, Position number_of_rows);
+	/*! \brief replaces the rows [begin,end) by a single run of value*/
+	void assign(Position begin, Position end, const T& value);
+	/*! \brief deletes the rows [begin,end), the following rows move to the front*/
+	void erase(Position begin, Position end);
+	/*! \brief returns the size in bytes the nodes consume in main memory*/
+	size_t getSizeinBytes() const throw();
+
+	private:
+	static const NodeID null_node = 0xFFFFFFFFu;
+	/*! the members are ordered by size, so a node of a four byte value takes 32 bytes*/
+	struct Node{
+		Node(const T& value_, Position length_, boost::uint32_t priority_) : value(value_), priority(priority_), left(null_node), right(null_node), length(length_), rows(length_){}
+		T value;
+		boost::uint32_t priority;
+		NodeID left;
+		NodeID right;
+		/*! number of rows of the run*/
+		Position length;
+		/*! number of rows in the subtree, outdated for the nodes on spine_*/
+		Position rows;
+	};
+
+	inline Position rows(NodeID node) const throw();
+	inline void updateRows(NodeID node);
+	NodeID newNode(const T& value, Position length);
+	/*! \brief moves all nodes of the subtree to the free list*/
+	void freeTree(NodeID node);
+	/*! \brief splits tree into the first number_of_rows rows and the remaining rows, a run on the border is split into two runs*/
+	void split(NodeID tree, Position number_of_rows, NodeID& first, NodeID& second);
+	/*! \brief concatenates the rows of two trees*/
+	NodeID merge(NodeID first, NodeID second);
+	NodeID firstRun(NodeID tree) const;
+	NodeID lastRun(NodeID tree) const;
+	/*! \brief adds number_of_rows rows to the last run of tree*/
+	void extendLastRun(NodeID tree, Position number_of_rows);
+	/*! \brief removes the first run of tree and returns the remaining tree*/
+	NodeID removeFirstRun(NodeID tree);
+	/*! \brief completes the row counts of the right spine and empties spine_, has to be called before the tree is split or merged*/
+	void completeSpine();
+
+	std::vector<Node> nodes_;
+	std::vector<NodeID> free_nodes_;
+	NodeID root_;
+	/*! the right spine from the root to the last run while runs are appended, empty otherwise*/
+	std::vector<NodeID> spine_;
+	/*! number of rows of the tree, the row count of the root is outdated while runs are appended*/
+	Position number_of_rows_;
+	/*! state of the random number generator for the priorities*/
+	boost::uint32_t seed_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	template<class T>
+	const typename RunTree<T>::NodeID RunTree<T>::null_node;
+
+	template<class T>
+	RunTree<T>::Cursor::Cursor(const RunTree<T>& tree) : tree_(&tree), ancestors_(), node_(null_node), run_begin_(0){
+
+	}
+
+	template<class T>
+	RunTree<T>::Cursor::Cursor(const Cursor& cursor) : tree_(cursor.tree_), ancestors_(cursor.ancestors_), node_(cursor.node_), run_begin_(cursor.run_begin_){
+
+	}
+
+	template<class T>
+	typename RunTree<T>::Cursor& RunTree<T>::Cursor::operator=(const Cursor& cursor){
+		tree_=cursor.tree_;
+		ancestors_=cursor.ancestors_;
+		node_=cursor.node_;
+		run_begin_=cursor.run_begin_;
+		return *this;
+	}
+
+	template<class T>
+	inline bool RunTree<T>::Cursor::valid() const throw(){
+		return node_!=null_node;
+	}
+
+	template<class T>
+	inline const T& RunTree<T>::Cursor::value() const throw(){
+		return tree_->nodes_[node_].value;
+	}
+
+	template<class T>
+	inline typename RunTree<T>::Position RunTree<T>::Cursor::getRunBegin() const throw(){
+		return run_begin_;
+	}
+
+	template<class T>
+	inline typename RunTree<T>::Position RunTree<T>::Cursor::getRunEnd() const throw(){
+		return run_begin_+tree_->nodes_[node_].length;
+	}
+
+	template<class T>
+	inline void RunTree<T>::Cursor::next(){
+		const std::vector<Node>& nodes = tree_->nodes_;
+		run_begin_+=nodes[node_].length;
+		NodeID node = nodes[node_].right;
+		if(node==null_node){
+			if(ancestors_.empty()){
+				node_=null_node;
+				return;
+			}
+			node_=ancestors_.back();
+			ancestors_.pop_back();
+			return;
+		}
+		//the next run is the leftmost run of the right subtree
+		while(nodes[node].left!=null_node){
+			ancestors_.push_back(node);
+			node=nodes[node].left;
+		}
+		node_=node;
+	}
+
+	template<class T>
+	RunTree<T>::RunTree() : nodes_(), free_nodes_(), root_(null_node), spine_(), number_of_rows_(0), seed_(2463534242u){
+
+	}
+
+	template<class T>
+	typename RunTree<T>::Position RunTree<T>::size() const throw(){
+		return number_of_rows_;
+	}
+
+	template<class T>
+	size_t RunTree<T>::getNumberOfRuns() const throw(){
+		return nodes_.size()-free_nodes_.size();
+	}
+
+	template<class T>
+	bool RunTree<T>::empty() const throw(){
+		return root_==null_node;
+	}
+
+	template<class T>
+	void RunTree<T>::clear(){
+		nodes_.clear();
+		free_nodes_.clear();
+		root_=null_node;
+		spine_.clear();
+		number_of_rows_=0;
+	}
+
+	template<class T>
+	const T& RunTree<T>::operator[](Position position) const{
+		NodeID node = root_;
+		while(true){
+			const Node& n = nodes_[node];
+			const Position left_rows = rows(n.left);
+			if(position<left_rows){
+				node=n.left;
+			}else if(position-left_rows<n.length){
+				return n.value;
+			}else{
+				position-=left_rows+n.length;
+				node=n.right;
+			}
+		}
+	}
+
+	template<class T>
+	typename RunTree<T>::Cursor RunTree<T>::find(Position position) const{
+		Cursor cursor(*this);
+		if(position>=size()) return cursor;
+		NodeID node = root_;
+		while(true){
+			const Node& n = nodes_[node];
+			const Position left_rows = rows(n.left);
+			if(position<left_rows){
+				cursor.ancestors_.push_back(node);
+				node=n.left;
+			}else if(position-left_rows<n.length){
+				cursor.node_=node;
+				cursor.run_begin_+=left_rows;
+				return cursor;
+			}else{
+				position-=left_rows+n.length;
+				cursor.run_begin_+=left_rows+n.length;
+				node=n.right;
+			}
+		}
+	}
+
+	template<class T>
+	typename RunTree<T>::Cursor RunTree<T>::begin() const{
+		return find(0);
+	}
+
+	template<class T>
+	void RunTree<T>::append(const T& value, Position number_of_rows){
+		if(number_of_rows==0) return;
+		if(spine_.empty()){
+			for(NodeID node=root_;node!=null_node;node=nodes_[node].right){
+				spine_.push_back(node);
+			}
+		}
+		number_of_rows_+=number_of_rows;
+		//the descent to a row only reads the row counts of left subtrees, so the outdated counts of the spine do not matter
+		if(!spine_.empty() && nodes_[spine_.back()].value==value){
+			nodes_[spine_.back()].length+=number_of_rows;
+			return;
+		}
+		//the nodes of the spine with a lower priority become the left subtree of the new run, their row counts are completed on the way
+		const NodeID run = newNode(value,number_of_rows);
+		NodeID left = null_node;
+		while(!spine_.empty() && !(nodes_[spine_.back()].priority>nodes_[run].priority)){
+			const NodeID node = spine_.back();
+			spine_.pop_back();
+			nodes_[node].right=left;
+			updateRows(node);
+			left=node;
+		}
+		nodes_[run].left=left;
+		if(spine_.empty()){
+			root_=run;
+		}else{
+			nodes_[spine_.back()].right=run;
+		}
+		spine_.push_back(run);
+	}
+
+	template<class T>
+	void RunTree<T>::assign(Position begin, Position end, const T& value){
+		end = std::min(end,size());
+		if(begin>=end) return;
+		completeSpine();
+		NodeID front, middle, back;
+		split(root_,begin,front,back);
+		split(back,end-begin,middle,back);
+		freeTree(middle);
+		Position number_of_rows = end-begin;
+		if(back!=null_node && nodes_[firstRun(back)].value==value){
+			number_of_rows+=nodes_[firstRun(back)].length;
+			back=removeFirstRun(back);
+		}
+		if(front!=null_node && nodes_[lastRun(front)].value==value){
+			extendLastRun(front,number_of_rows);
+			root_=merge(front,back);
+		}else{
+			const NodeID run = newNode(value,number_of_rows);
+			root_=merge(merge(front,run),back);
+		}
+		number_of_rows_=rows(root_);
+	}
+
+	template<class T>
+	void RunTree<T>::erase(Position begin, Position end){
+		end = std::min(end,size());
+		if(begin>=end) return;
+		completeSpine();
+		NodeID front, middle, back;
+		split(root_,begin,front,back);
+		split(back,end-begin,middle,back);
+		freeTree(middle);
+		//the runs in front of and behind the gap may have the same value
+		if(front!=null_node && back!=null_node && nodes_[lastRun(front)].value==nodes_[firstRun(back)].value){
+			const Position number_of_rows = nodes_[firstRun(back)].length;
+			back=removeFirstRun(back);
+			extendLastRun(front,number_of_rows);
+		}
+		root_=merge(front,back);
+		number_of_rows_=rows(root_);
+	}
+
+	template<class T>
+	size_t RunTree<T>::getSizeinBytes() const throw(){
+		return nodes_.capacity()*sizeof(Node)+(free_nodes_.capacity()+spine_.capacity())*sizeof(NodeID);
+	}
+
+	template<class T>
+	inline typename RunTree<T>::Position RunTree<T>::rows(NodeID node) const throw(){
+		return node==null_node ? 0 : nodes_[node].rows;
+	}
+
+	template<class T>
+	inline void RunTree<T>::updateRows(NodeID node){
+		nodes_[node].rows = rows(nodes_[node].left)+nodes_[node].length+rows(nodes_[node].right);
+	}
+
+	template<class T>
+	typename RunTree<T>::NodeID RunTree<T>::newNode(const T& value, Position length){
+		//xorshift generator
+		seed_ ^= seed_ << 13;
+		seed_ ^= seed_ >> 17;
+		seed_ ^= seed_ << 5;
+		if(free_nodes_.empty()){
+			nodes_.push_back(Node(value,length,seed_));
+			return NodeID(nodes_.size()-1);
+		}
+		const NodeID node = free_nodes_.back();
+		free_nodes_.pop_back();
+		nodes_[node]=Node(value,length,seed_);
+		return node;
+	}
+
+	template<class T>
+	void RunTree<T>::freeTree(NodeID node){
+		if(node==null_node) return;
+		std::vector<NodeID> pending(1,node);
+		while(!pending.empty()){
+			node=pending.back();
+			pending.pop_back();
+			free_nodes_.push_back(node);
+			if(nodes_[node].left!=null_node) pending.push_back(nodes_[node].left);
+			if(nodes_[node].right!=null_node) pending.push_back(nodes_[node].right);
+		}
+	}
+
+	template<class T>
+	void RunTree<T>::split(NodeID tree, Position number_of_rows, NodeID& first, NodeID& second){
+		if(tree==null_node){
+			first=second=null_node;
+			return;
+		}
+		//nodes_ may grow while splitting, so no references to nodes are kept
+		const Position left_rows = rows(nodes_[tree].left);
+		if(number_of_rows<=left_rows){
+			NodeID left;
+			split(nodes_[tree].left,number_of_rows,first,left);
+			nodes_[tree].left=left;
+			updateRows(tree);
+			second=tree;
+		}else if(number_of_rows>=left_rows+nodes_[tree].length){
+			NodeID right;
+			split(nodes_[tree].right,number_of_rows-left_rows-nodes_[tree].length,right,second);
+			nodes_[tree].right=right;
+			updateRows(tree);
+			first=tree;
+		}else{
+			//the border lies inside the run, the rows behind the border become a new run, which inherits
+			//the priority and the right subtree, so the heap order is kept
+			const Position length = number_of_rows-left_rows;
+			const NodeID run = newNode(nodes_[tree].value,nodes_[tree].length-length);
+			nodes_[run].priority=nodes_[tree].priority;
+			nodes_[run].right=nodes_[tree].right;
+			updateRows(run);
+			nodes_[tree].right=null_node;
+			nodes_[tree].length=length;
+			updateRows(tree);
+			first=tree;
+			second=run;
+		}
+	}
+
+	template<class T>
+	typename RunTree<T>::NodeID RunTree<T>::merge(NodeID first, NodeID second){
+		if(first==null_node) return second;
+		if(second==null_node) return first;
+		if(nodes_[first].priority>nodes_[second].priority){
+			const NodeID right = merge(nodes_[first].right,second);
+			nodes_[first].right=right;
+			updateRows(first);
+			return first;
+		}else{
+			const NodeID left = merge(first,nodes_[second].left);
+			nodes_[second].left=left;
+			updateRows(second);
+			return second;
+		}
+	}
+
+	template<class T>
+	typename RunTree<T>::NodeID RunTree<T>::firstRun(NodeID tree) const{
+		while(nodes_[tree].left!=null_node) tree=nodes_[tree].left;
+		return tree;
+	}
+
+	template<class T>
+	typename RunTree<T>::NodeID RunTree<T>::lastRun(NodeID tree) const{
+		while(nodes_[tree].right!=null_node) tree=nodes_[tree].right;
+		return tree;
+	}
+
+	template<class T>
+	void RunTree<T>::extendLastRun(NodeID tree, Position number_of_rows){
+		while(true){
+			nodes_[tree].rows+=number_of_rows;
+			if(nodes_[tree].right==null_node) break;
+			tree=nodes_[tree].right;
+		}
+		nodes_[tree].length+=number_of_rows;
+	}
+
+	template<class T>
+	typename RunTree<T>::NodeID RunTree<T>::removeFirstRun(NodeID tree){
+		NodeID first, remaining;
+		split(tree,nodes_[firstRun(tree)].length,first,remaining);
+		freeTree(first);
+		return remaining;
+	}
+
+	template<class T>
+	void RunTree<T>::completeSpine(){
+		//the counts are completed from the last run upwards, so every node adds the complete count of its right child
+		while(!spine_.empty()){
+			updateRows(spine_.back());
+			spine_.pop_back();
+		}
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
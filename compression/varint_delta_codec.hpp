@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include <compression/delta_codec.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This block stores the value of its first row and the delta of every further row to its predecessor as a variable length integer.
+ *  \details   A delta is zig-zag encoded, so deltas of small magnitude become small unsigned numbers independent of their sign. The number
+ *             is written in groups of 7 bits, lowest first, the highest bit of a byte tells whether another byte follows (LEB128). Small
+ *             deltas take a single byte. A row is decoded by reading the deltas in front of it in its block. The blocks hold more rows than
+ *             the blocks with fixed length deltas, so the header of a block adds less than a quarter byte per row.
+ */
+class VarintDeltaBlock{
+	public:
+	/*! \brief maximal number of rows per block*/
+	static const size_t block_size=256;
+	/***************** constructors and destructor *****************/
+	VarintDeltaBlock();
+
+	size_t size() const throw();
+	void encode(const int* values, size_t number_of_values);
+	int get(size_t index) const;
+	void decode(int* values) const;
+	size_t getSizeinBytes() const throw();
+	void swap(VarintDeltaBlock& block);
+
+	/*! \brief maps signed numbers of small magnitude to small unsigned numbers: 0,-1,1,-2,... to 0,1,2,3,...*/
+	static inline boost::uint32_t zigzagEncode(boost::int32_t value);
+	static inline boost::int32_t zigzagDecode(boost::uint32_t value);
+	/*! \brief reads the number at position in the stream and moves position behind it*/
+	static inline boost::uint32_t readVarint(const boost::uint8_t*& position);
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & bytes_;
+		ar & first_value_;
+		ar & number_of_rows_;
+	}
+
+	/*! \brief writes the varint of the delta of value to base to position and returns the position behind it*/
+	static boost::uint8_t* writeDelta(boost::int32_t value, boost::int32_t base, boost::uint8_t* position);
+
+	/*! zig-zag and LEB128 encoded deltas of the rows behind the first row*/
+	std::vector<boost::uint8_t> bytes_;
+	boost::int32_t first_value_;
+	boost::uint16_t number_of_rows_;
+};
+
+/*! \brief the codec of integer columns with variable length deltas*/
+typedef BlockedDeltaCodec<int,VarintDeltaBlock> VarintDeltaCodec;
+
+/***************** Start of Implementation Section ******************/
+
+	inline VarintDeltaBlock::VarintDeltaBlock() : bytes_(), first_value_(0), number_of_rows_(0){
+
+	}
+
+	inline size_t VarintDeltaBlock::size() const throw(){
+		return number_of_rows_;
+	}
+
+	inline boost::uint32_t VarintDeltaBlock::zigzagEncode(boost::int32_t value){
+		return (boost::uint32_t(value) << 1) ^ boost::uint32_t(value >> 31);
+	}
+
+	inline boost::int32_t VarintDeltaBlock::zigzagDecode(boost::uint32_t value){
+		return boost::int32_t((value >> 1) ^ (0u-(value & 1)));
+	}
+
+	inline boost::uint32_t VarintDeltaBlock::readVarint(const boost::uint8_t*& position){
+		//nearly sorted columns have small deltas, so the loop ends after the first byte almost always
+		boost::uint32_t value = *position & 0x7F;
+		unsigned int shift = 7;
+		while(*position++ & 0x80){
+			value |= boost::uint32_t(*position & 0x7F) << shift;
+			shift += 7;
+		}
+		return value;
+	}
+
+	inline boost::uint8_t* VarintDeltaBlock::writeDelta(boost::int32_t value, boost::int32_t base, boost::uint8_t* position){
+		//the delta is computed modulo 2^32, so no difference of two integers overflows
+		boost::uint32_t delta = zigzagEncode(boost::int32_t(boost::uint32_t(value)-boost::uint32_t(base)));
+		while(delta>=0x80){
+			*position++ = boost::uint8_t(delta | 0x80);
+			delta >>= 7;
+		}
+		*position++ = boost::uint8_t(delta);
+		return position;
+	}
+
+	inline void VarintDeltaBlock::encode(const int* values, size_t number_of_values){
+		//a delta takes at most five bytes
+		boost::uint8_t bytes[5*block_size];
+		boost::uint8_t* end = bytes;
+		for(size_t i=1;i<number_of_values;i++){
+			end = writeDelta(values[i],values[i-1],end);
+		}
+		//the new vector has no spare capacity
+		std::vector<boost::uint8_t>(bytes,end).swap(bytes_);
+		first_value_ = number_of_values==0 ? 0 : values[0];
+		number_of_rows_ = boost::uint16_t(number_of_values);
+	}
+
+	inline int VarintDeltaBlock::get(size_t index) const{
+		boost::uint32_t value = boost::uint32_t(first_value_);
+		const boost::uint8_t* position = bytes_.empty() ? 0 : &bytes_[0];
+		for(size_t i=0;i<index;i++){
+			value += boost::uint32_t(zigzagDecode(readVarint(position)));
+		}
+		return int(value);
+	}
+
+	inline void VarintDeltaBlock::decode(int* values) const{
+		if(number_of_rows_==0) return;
+		boost::uint32_t value = boost::uint32_t(first_value_);
+		const boost::uint8_t* position = bytes_.empty() ? 0 : &bytes_[0];
+		values[0] = first_value_;
+		for(size_t i=1;i<number_of_rows_;i++){
+			value += boost::uint32_t(zigzagDecode(readVarint(position)));
+			values[i] = int(value);
+		}
+	}
+
+	inline size_t VarintDeltaBlock::getSizeinBytes() const throw(){
+		return bytes_.capacity();
+	}
+
+	inline void VarintDeltaBlock::swap(VarintDeltaBlock& block){
+		bytes_.swap(block.bytes_);
+		std::swap(first_value_,block.first_value_);
+		std::swap(number_of_rows_,block.number_of_rows_);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+
+#include <compression/delta_codec.hpp>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     This block stores every float as the XOR of its bits with the bits of its predecessor, without the leading and trailing zeros of the result.
+ *  \details   Neighbouring values of a column differ in few bits, so the XOR has long runs of zeros at both ends. A value equal to its predecessor
+ *             takes a single bit. Otherwise the meaningful bits are stored either in the bit window of the last stored XOR, if they fit, or behind
+ *             the number of leading zeros and the length of the new window. Floats are never subtracted, so every value is restored bit-exactly.
+ *             The first row of a block is stored with all its bits, so a row is decoded from its block only.
+ */
+class XorFloatBlock{
+	public:
+	/*! \brief maximal number of rows per block*/
+	static const size_t block_size=128;
+	/***************** constructors and destructor *****************/
+	XorFloatBlock();
+
+	size_t size() const throw();
+	void encode(const float* values, size_t number_of_values);
+	float get(size_t index) const;
+	void decode(float* values) const;
+	size_t getSizeinBytes() const throw();
+	void swap(XorFloatBlock& block);
+
+	private:
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int){
+		ar & words_;
+		ar & number_of_rows_;
+	}
+
+	/*! \brief the state of a decoder, which walks through the rows of the block*/
+	struct Decoder{
+		boost::uint64_t position;
+		boost::uint32_t bits;
+		unsigned int leading;
+		unsigned int length;
+	};
+	/*! \brief maximal number of words of a block, the first row takes 32 bits and every further row at most 44 bits*/
+	static const size_t max_words=(32+(block_size-1)*44+63)/64;
+	/*! \brief writes the lowest number_of_bits bits of value to the zero initialized words at position and moves position behind them, number_of_bits is at most 32*/
+	static void writeBits(boost::uint64_t value, unsigned int number_of_bits, boost::uint64_t* words, boost::uint64_t& position);
+	/*! \brief returns the number_of_bits bits at position in the stream, number_of_bits is at most 32*/
+	boost::uint64_t readBits(boost::uint64_t position, unsigned int number_of_bits) const;
+	/*! \brief returns a decoder positioned on the first row*/
+	Decoder seek() const;
+	/*! \brief moves the decoder from its row to the next row*/
+	void next(Decoder& decoder) const;
+	static inline boost::uint32_t toBits(float value);
+	static inline float toFloat(boost::uint32_t bits);
+
+	/*! control bits, XORs and the full value of the first row, the lowest bit of a word comes first*/
+	std::vector<boost::uint64_t> words_;
+	boost::uint16_t number_of_rows_;
+};
+
+/*! \brief the codec of float columns*/
+typedef BlockedDeltaCodec<float,XorFloatBlock> XorFloatCodec;
+
+/***************** Start of Implementation Section ******************/
+
+	inline XorFloatBlock::XorFloatBlock() : words_(), number_of_rows_(0){
+
+	}
+
+	inline size_t XorFloatBlock::size() const throw(){
+		return number_of_rows_;
+	}
+
+	inline boost::uint32_t XorFloatBlock::toBits(float value){
+		boost::uint32_t bits;
+		std::memcpy(&bits,&value,sizeof(bits));
+		return bits;
+	}
+
+	inline float XorFloatBlock::toFloat(boost::uint32_t bits){
+		float value;
+		std::memcpy(&value,&bits,sizeof(value));
+		return value;
+	}
+
+	inline void XorFloatBlock::writeBits(boost::uint64_t value, unsigned int number_of_bits, boost::uint64_t* words, boost::uint64_t& position){
+		const size_t word = size_t(position/64);
+		const unsigned int offset = unsigned(position%64);
+		words[word] |= value << offset;
+		if(offset+number_of_bits>64) words[word+1] |= value >> (64-offset);
+		position += number_of_bits;
+	}
+
+	inline boost::uint64_t XorFloatBlock::readBits(boost::uint64_t position, unsigned int number_of_bits) const{
+		const size_t word = size_t(position/64);
+		const unsigned int offset = unsigned(position%64);
+		boost::uint64_t value = words_[word] >> offset;
+		if(offset+number_of_bits>64) value |= words_[word+1] << (64-offset);
+		return value & ((boost::uint64_t(1) << number_of_bits)-1);
+	}
+
+	inline void XorFloatBlock::encode(const float* values, size_t number_of_values){
+		boost::uint64_t words[max_words];
+		std::fill(words,words+max_words,0);
+		boost::uint64_t position = 0;
+		if(number_of_values>0) writeBits(toBits(values[0]),32,words,position);
+		//leading zeros and length of the window of the last stored XOR, a window of 32 leading zeros is empty
+		unsigned int window_leading = 32;
+		unsigned int window_length = 0;
+		for(size_t i=1;i<number_of_values;i++){
+			const boost::uint32_t change = toBits(values[i]) ^ toBits(values[i-1]);
+			if(change==0){
+				//control bit 0: same value as the predecessor
+				writeBits(0,1,words,position);
+			}else{
+				const unsigned int leading = __builtin_clz(change);
+				const unsigned int trailing = __builtin_ctz(change);
+				if(leading>=window_leading && trailing>=32-window_leading-window_length){
+					//control bits 1,0: the meaningful bits fit into the current window
+					writeBits(1,2,words,position);
+					writeBits(change >> (32-window_leading-window_length),window_length,words,position);
+				}else{
+					//control bits 1,1: a new window of 5 bits leading zeros and 5 bits length-1
+					window_leading=leading;
+					window_length=32-leading-trailing;
+					writeBits(3,2,words,position);
+					writeBits(window_leading,5,words,position);
+					writeBits(window_length-1,5,words,position);
+					writeBits(change >> trailing,window_length,words,position);
+				}
+			}
+		}
+		//the new vector has no spare capacity
+		std::vector<boost::uint64_t>(words,words+size_t((position+63)/64)).swap(words_);
+		number_of_rows_ = boost::uint16_t(number_of_values);
+	}
+
+	inline XorFloatBlock::Decoder XorFloatBlock::seek() const{
+		Decoder decoder;
+		decoder.position = 32;
+		decoder.bits = boost::uint32_t(readBits(0,32));
+		decoder.leading = 32;
+		decoder.length = 0;
+		return decoder;
+	}
+
+	inline void XorFloatBlock::next(Decoder& decoder) const{
+		//the control bits are read one by one, the stream may end behind the first one
+		if(readBits(decoder.position,1)==0){
+			decoder.position += 1;
+			return;
+		}
+		const bool new_window = readBits(decoder.position+1,1)==1;
+		decoder.position += 2;
+		if(new_window){
+			decoder.leading = unsigned(readBits(decoder.position,5));
+			decoder.length = unsigned(readBits(decoder.position+5,5))+1;
+			decoder.position += 10;
+		}
+		const unsigned int trailing = 32-decoder.leading-decoder.length;
+		decoder.bits ^= boost::uint32_t(readBits(decoder.position,decoder.length)) << trailing;
+		decoder.position += decoder.length;
+	}
+
+	inline float XorFloatBlock::get(size_t index) const{
+		Decoder decoder = seek();
+		for(size_t i=0;i<index;i++){
+			next(decoder);
+		}
+		return toFloat(decoder.bits);
+	}
+
+	inline void XorFloatBlock::decode(float* values) const{
+		if(number_of_rows_==0) return;
+		Decoder decoder = seek();
+		values[0] = toFloat(decoder.bits);
+		for(size_t i=1;i<number_of_rows_;i++){
+			next(decoder);
+			values[i] = toFloat(decoder.bits);
+		}
+	}
+
+	inline size_t XorFloatBlock::getSizeinBytes() const throw(){
+		return words_.capacity()*sizeof(boost::uint64_t);
+	}
+
+	inline void XorFloatBlock::swap(XorFloatBlock& block){
+		words_.swap(block.words_);
+		std::swap(number_of_rows_,block.number_of_rows_);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
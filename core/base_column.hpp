@@ -22,6 +22,10 @@ typedef std::pair<PositionListPtr,PositionListPtr> PositionListPair;
 /* \brief a PositionListPairPtr is a a references counted smart pointer to a PositionListPair object*/
 typedef shared_pointer_namespace::shared_ptr<PositionListPair> PositionListPairPtr;
 
+class PositionIntervalList; //forward declaration, defined in core/position_interval_list.hpp
+/* \brief a PositionIntervalListPtr is a a references counted smart pointer to a PositionIntervalList object, which stores tids as intervals*/
+typedef shared_pointer_namespace::shared_ptr<PositionIntervalList> PositionIntervalListPtr;
+
 class Table; //forward declaration
 
 /*!
@@ -52,6 +56,10 @@ class ColumnBase{
 	/*! \brief updates the values specified by the position list with a value new_Value
 	 *  \return true for sucess and false in case an error occured*/	
 	virtual bool update(PositionListPtr tids, const boost::any& new_value) = 0;		
+	/*! \brief updates the values in the tid intervals with a value new_Value
+	 *  \details the default implementation updates tid by tid without expanding the intervals
+	 *  \return true for sucess and false in case an error occured*/	
+	virtual bool update(PositionIntervalListPtr tids, const boost::any& new_value);		
 	/*! \brief deletes the value on position tid
 	 *  \return true for sucess and false in case an error occured*/
 	virtual bool remove(TID tid)=0;
@@ -59,6 +67,10 @@ class ColumnBase{
 	 *  \details assumes tid list is sorted ascending
 	 *  \return true for sucess and false in case an error occured*/		
 	virtual bool remove(PositionListPtr tid)=0;	
+	/*! \brief deletes the values in the tid intervals
+	 *  \details the default implementation deletes tid by tid from the back without expanding the intervals
+	 *  \return true for sucess and false in case an error occured*/		
+	virtual bool remove(PositionIntervalListPtr tids);	
 	/*! \brief deletes all values stored in the column
 	 *  \return true for sucess and false in case an error occured*/	
 	virtual bool clearContent()=0;
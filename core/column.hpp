@@ -1,8 +1,10 @@
 #pragma once
 
 #include <core/column_base_typed.hpp>
+#include <core/position_interval_list.hpp>
 #include <iostream>
 #include <fstream>
+#include <map>
 
 namespace CoGaDB{
 
@@ -21,10 +23,14 @@ class Column : public ColumnBaseTyped<T>{
 
 	virtual bool update(TID tid, const boost::any& new_value);
 	virtual bool update(PositionListPtr tid, const boost::any& new_value);	
+	/*! \brief fills the rows of every interval with the new value*/
+	virtual bool update(PositionIntervalListPtr tids, const boost::any& new_value);
 	
 	virtual bool remove(TID tid);
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid);
+	/*! \brief removes the rows of all intervals in one pass, which moves the rows between the intervals to the front*/
+	virtual bool remove(PositionIntervalListPtr tids);
 	virtual bool clearContent();
 
 	virtual const boost::any get(TID tid);
@@ -140,12 +146,45 @@ class Column : public ColumnBaseTyped<T>{
 
 
 
+	template<class T>
+	bool Column<T>::update(PositionIntervalListPtr tids, const boost::any& new_value){
+		if(!tids) return false;
+		if(new_value.empty()) return false;
+		if(typeid(T)!=new_value.type()){
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			return false;
+		}
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(!tids->empty() && tids->rbegin()->second>values_.size()) return false;
+		T value = boost::any_cast<T>(new_value);
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			std::fill(values_.begin()+it->first,values_.begin()+it->second,value);
+		}
+		return true;
+	}
+
 	template<class T>
 	bool Column<T>::remove(TID tid){
 		values_.erase(values_.begin()+tid);
 		return true;
 	}
 	
+	template<class T>
+	bool Column<T>::remove(PositionIntervalListPtr tids){
+		if(!tids) return false;
+		if(tids->empty()) return false;
+		//the intervals are sorted, so only the last one may reach behind the last row
+		if(tids->rbegin()->second>values_.size()) return false;
+		typename std::vector<T>::iterator kept = values_.begin()+tids->begin()->first;
+		for(PositionIntervalList::const_iterator it=tids->begin();it!=tids->end();++it){
+			//the rows up to the next interval move behind the rows kept so far
+			const TID next_begin = it+1==tids->end() ? TID(values_.size()) : (it+1)->first;
+			kept = std::copy(values_.begin()+it->second,values_.begin()+next_begin,kept);
+		}
+		values_.erase(kept,values_.end());
+		return true;
+	}
+
 	template<class T>
 	bool Column<T>::remove(PositionListPtr tids){
 		if(!tids)
@@ -294,6 +333,35 @@ class Column : public ColumnBaseTyped<T>{
 		return size_in_bytes;
 	}
 
+	/*! the generic aggregate_by_keys of ColumnBaseTyped returns materialized columns, so it is defined here*/
+	template<class T>
+	template <typename U>
+	std::pair<ColumnPtr,ColumnPtr> ColumnBaseTyped<T>::aggregate_by_keys(ColumnBaseTyped<U>& values, AggregationMethod agg_meth, unsigned int){
+		if(this->size()!=values.size()){
+			std::cout << "Fatal Error!!! Columns " << this->name_  << " and " << values.getName() << " differ in size" << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			return std::pair<ColumnPtr,ColumnPtr>();
+		}
+		if(!check_aggregation_method<U>(agg_meth,values.getName())) return std::pair<ColumnPtr,ColumnPtr>();
+		typedef std::map<T,U> Groups;
+		Groups groups;
+		typename ColumnBaseTyped<U>::Cursor value(values);
+		for(Cursor key(*this);key.valid();key.next(),value.next()){
+			std::pair<typename Groups::iterator,bool> group = groups.insert(std::make_pair(key.value(),value.value()));
+			if(!group.second){
+				aggregate_value(group.first->second,value.value(),agg_meth);
+			}
+		}
+
+		shared_pointer_namespace::shared_ptr<Column<T> > keys( new Column<T>(this->name_,this->db_type_) );
+		shared_pointer_namespace::shared_ptr<Column<U> > aggregates( new Column<U>(values.getName(),values.getType()) );
+		for(typename Groups::iterator it=groups.begin();it!=groups.end();++it){
+			keys->insert(it->first);
+			aggregates->insert(it->second);
+		}
+		return std::pair<ColumnPtr,ColumnPtr>(keys,aggregates);
+	}
+
 /***************** End of Implementation Section ******************/
 
 
@@ -41,10 +41,12 @@ class ColumnBaseTyped : public ColumnBase{
 	virtual bool insert(const T& new_Value)=0;
 	virtual bool update(TID tid, const boost::any& new_value) = 0;
 	virtual bool update(PositionListPtr tid, const boost::any& new_value) = 0;	
+	using ColumnBase::update;
 	
 	virtual bool remove(TID tid)=0;
 	//assumes tid list is sorted ascending
 	virtual bool remove(PositionListPtr tid)=0;
+	using ColumnBase::remove;
 	virtual bool clearContent()=0;
 
 	virtual const boost::any get(TID tid)=0;
@@ -77,8 +79,17 @@ class ColumnBaseTyped : public ColumnBase{
 	virtual bool division(const boost::any& new_Value);	
 	virtual bool division(ColumnPtr join_column);	
 
-	//template <typename U, typename BinaryOperator>
-	//std::pair<ColumnPtr,ColumnPtr> aggregate_by_keys(ColumnBaseTyped<U>* keys, BinaryOperator binary_op) const;
+	/*! \brief groups the rows by the values of this column and aggregates the corresponding rows of the column values per group
+	 *  \details the generic implementation uses a search tree and ignores the number of threads, it is defined in core/column.hpp, because it returns materialized columns
+	 *  \return a pair of materialized columns, the first contains the keys in ascending order, the second the aggregates of the groups*/
+	template <typename U>
+	std::pair<ColumnPtr,ColumnPtr> aggregate_by_keys(ColumnBaseTyped<U>& values, AggregationMethod agg_meth, unsigned int number_of_threads=1);
+	/*! \brief aggregates all values of the column, returns a default constructed value for an empty column*/
+	virtual T aggregate(AggregationMethod agg_meth);
+	/*! \brief aggregates the values on the positions [begin,end)*/
+	virtual T aggregate(AggregationMethod agg_meth, TID begin, TID end);
+	/*! \brief aggregates the values on the positions in tids, e.g., the result of a selection*/
+	virtual T aggregate(AggregationMethod agg_meth, PositionListPtr tids);
 
 	virtual bool store(const std::string& path) = 0;
 	virtual bool load(const std::string& path) = 0;
@@ -92,6 +103,30 @@ class ColumnBaseTyped : public ColumnBase{
 	 * */
 	virtual T& operator[](const int index) = 0;
 	inline bool operator==(ColumnBaseTyped<T>& column);
+	/*! \brief copies the values on the positions [begin,begin+number_of_values) to values
+	 *  \details the generic implementation uses operator[], columns with a cheaper sequential access override it*/
+	virtual void getValues(TID begin, size_t number_of_values, T* values);
+
+	/*! \brief forward cursor over the values of a column
+	 *  \details The cursor fetches the values block wise with getValues, so a sequential scan costs one virtual call per block
+	 *  instead of one random access per row. The column must not be modified while a cursor is in use.*/
+	class Cursor{
+		public:
+		explicit Cursor(ColumnBaseTyped<T>& column, TID begin=0);
+		/*! \brief returns false, if the cursor moved behind the last row*/
+		inline bool valid() const throw();
+		inline const T& value() const throw();
+		inline TID getTID() const throw();
+		inline void next();
+		private:
+		void fetch();
+		static const size_t block_size=1024;
+		ColumnBaseTyped<T>& column_;
+		std::vector<T> block_;
+		TID block_begin_;
+		size_t offset_;
+		size_t number_of_rows_;
+	};
 };
 
 
@@ -110,14 +145,64 @@ const std::type_info& ColumnBaseTyped<T>::type() const throw(){
 	return typeid(T);
 }
 
+	template<class T>
+	void ColumnBaseTyped<T>::getValues(TID begin, size_t number_of_values, T* values){
+		for(size_t i=0;i<number_of_values;i++){
+			values[i]=(*this)[begin+i];
+		}
+	}
+
+	template<class T>
+	const size_t ColumnBaseTyped<T>::Cursor::block_size;
+
+	template<class T>
+	ColumnBaseTyped<T>::Cursor::Cursor(ColumnBaseTyped<T>& column, TID begin) : column_(column), block_(), block_begin_(begin), offset_(0), number_of_rows_(column.size()){
+		fetch();
+	}
+
+	template<class T>
+	inline bool ColumnBaseTyped<T>::Cursor::valid() const throw(){
+		return block_begin_+offset_<number_of_rows_;
+	}
+
+	template<class T>
+	inline const T& ColumnBaseTyped<T>::Cursor::value() const throw(){
+		return block_[offset_];
+	}
+
+	template<class T>
+	inline TID ColumnBaseTyped<T>::Cursor::getTID() const throw(){
+		return block_begin_+offset_;
+	}
+
+	template<class T>
+	inline void ColumnBaseTyped<T>::Cursor::next(){
+		if(++offset_==block_.size()){
+			block_begin_+=offset_;
+			offset_=0;
+			fetch();
+		}
+	}
+
+	template<class T>
+	void ColumnBaseTyped<T>::Cursor::fetch(){
+		if(block_begin_>=number_of_rows_){
+			block_.clear();
+			return;
+		}
+		block_.resize(std::min(block_size,number_of_rows_-block_begin_));
+		column_.getValues(block_begin_,block_.size(),&block_[0]);
+	}
+
 template<class T>
 const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
 
 	PositionListPtr ids = PositionListPtr( new PositionList());
 		std::vector<std::pair<T,TID> > v;
 
-		for(unsigned int i=0;i<this->size();i++){
-			v.push_back (std::pair<T,TID>((*this)[i],i) );
+		v.reserve(this->size());
+		for(Cursor cursor(*this);cursor.valid();cursor.next()){
+			v.push_back (std::pair<T,TID>(cursor.value(),cursor.getTID()) );
 		}
 
 		//TODO: change implementation, so that no copy operations are required -> use boost zip iterators!
@@ -166,24 +251,24 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 				result_tids = PositionListPtr(new PositionList());
 
 				if(!quiet) std::cout << "Using CPU for Selection..." << std::endl;
-				for(TID i=0;i<this->size();i++){
+				for(Cursor cursor(*this);cursor.valid();cursor.next()){
 		
 					//boost::any value = column->get(i);
 					//val = values_[i];
 			
 					if(comp==EQUAL){
-					if(value==(*this)[i]){
+					if(value==cursor.value()){
 						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
+						result_tids->push_back(cursor.getTID());
 					}
 					}else if(comp==LESSER){
-					if((*this)[i]<value){
+					if(cursor.value()<value){
 						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
+						result_tids->push_back(cursor.getTID());
 					}
 					}else if(comp==GREATER){
-					if((*this)[i]>value){
-						result_tids->push_back(i);
+					if(cursor.value()>value){
+						result_tids->push_back(cursor.getTID());
 						//result_table->insert(this->fetchTuple(i));
 					}
 					}else{
@@ -216,18 +301,23 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 
 	//create hash table
 	HashTable hashtable;
-	for(unsigned int i=0;i<this->size();i++)	
+	for(Cursor cursor(*this);cursor.valid();cursor.next())	
 		hashtable.insert(
-								std::pair<T,TID> ((*this)[i],i)
+								std::pair<T,TID> (cursor.value(),cursor.getTID())
 					);
 
-	//probe larger relation
-	for(unsigned int i=0;i<join_column->size();i++){
-		std::pair<typename HashTable::iterator, typename HashTable::iterator> range =  hashtable.equal_range((*join_column)[i]);
+	//probe larger relation, consecutive rows with the same value reuse the matches of their predecessor
+	std::pair<typename HashTable::iterator, typename HashTable::iterator> range;
+	T last_value = T();
+	for(Cursor cursor(*join_column);cursor.valid();cursor.next()){
+		if(cursor.getTID()==0 || !(cursor.value()==last_value)){
+			last_value = cursor.value();
+			range = hashtable.equal_range(last_value);
+		}
 		for(typename HashTable::iterator it=range.first ; it!=range.second;it++){
-			if(it->first==(*join_column)[i]){
+			if(it->first==cursor.value()){
 				join_tids->first->push_back(it->second);
-				join_tids->second->push_back(i);
+				join_tids->second->push_back(cursor.getTID());
 				//cout << "match! " << it->second << ", " << i << "	"  << it->first << endl;
 			}
 		}
@@ -283,11 +373,71 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 		return join_tids;
 	}
 
+	/*! \brief returns whether the aggregation method is defined on values of type U*/
+	template<class U>
+	inline bool is_aggregation_defined(AggregationMethod){
+		return true;
+	}
+
+	/*! \brief reports an error for aggregation methods, which are undefined on values of type U*/
+	template<class U>
+	inline bool check_aggregation_method(AggregationMethod agg_meth, const std::string& column_name){
+		if(is_aggregation_defined<U>(agg_meth)) return true;
+		std::cout << "Fatal Error!!! Aggregation method " << agg_meth << " is undefined on the values of column " << column_name << std::endl;
+		std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+		return false;
+	}
+
+	/*! \brief adds value to the aggregate of a group according to the aggregation method*/
+	template<class U>
+	inline void aggregate_value(U& aggregate, const U& value, AggregationMethod agg_meth){
+		if(agg_meth==SUM){
+			aggregate+=value;
+		}else if(agg_meth==MIN){
+			if(value<aggregate) aggregate=value;
+		}else if(agg_meth==MAX){
+			if(aggregate<value) aggregate=value;
+		}
+	}
+
+	template<class T>
+	T ColumnBaseTyped<T>::aggregate(AggregationMethod agg_meth){
+		return aggregate(agg_meth,0,TID(this->size()));
+	}
+
+	template<class T>
+	T ColumnBaseTyped<T>::aggregate(AggregationMethod agg_meth, TID begin, TID end){
+		T result = T();
+		if(!check_aggregation_method<T>(agg_meth,this->name_)) return result;
+		if(begin>=end || begin>=this->size()) return result;
+		Cursor cursor(*this,begin);
+		result=cursor.value();
+		for(cursor.next();cursor.valid() && cursor.getTID()<end;cursor.next()){
+			aggregate_value(result,cursor.value(),agg_meth);
+		}
+		return result;
+	}
+
+	template<class T>
+	T ColumnBaseTyped<T>::aggregate(AggregationMethod agg_meth, PositionListPtr tids){
+		T result = T();
+		if(!tids || !check_aggregation_method<T>(agg_meth,this->name_)) return result;
+		for(unsigned int i=0;i<tids->size();i++){
+			if(i==0){
+				result=(*this)[(*tids)[i]];
+			}else{
+				aggregate_value(result,(*this)[(*tids)[i]],agg_meth);
+			}
+		}
+		return result;
+	}
+
 	template<class T>
 	bool ColumnBaseTyped<T>::operator==(ColumnBaseTyped<T>& column){
 	  if(this->size()!=column.size()) return false;
-	  for(unsigned int i=0;i<this->size();i++){
-			if((*this)[i]!=column[i]){ 	
+	  Cursor other(column);
+	  for(Cursor cursor(*this);cursor.valid();cursor.next(),other.next()){
+			if(cursor.value()!=other.value()){ 	
 				return false;
 			}
 	  }
@@ -424,5 +574,24 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 	template<>
 	inline bool ColumnBaseTyped<std::string>::division(ColumnPtr){ return false;	}
 
+	template<>
+	inline bool is_aggregation_defined<std::string>(AggregationMethod agg_meth){
+		//a sum is undefined on strings
+		return agg_meth!=SUM;
+	}
+
+	template<>
+	inline void aggregate_value(std::string& aggregate, const std::string& value, AggregationMethod agg_meth){
+		//the aggregation methods reject a sum before they aggregate the first value
+		if(agg_meth==SUM){
+			std::cout << "Fatal Error!!! SUM is undefined on strings" << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+		}else if(agg_meth==MIN){
+			if(value<aggregate) aggregate=value;
+		}else if(agg_meth==MAX){
+			if(aggregate<value) aggregate=value;
+		}
+	}
+
 }; //end namespace CogaDB
 
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+
+#include <core/base_column.hpp>
+
+namespace CoGaDB{
+
+/* \brief a TIDInterval is the range of tids [first,second)*/
+typedef std::pair<TID,TID> TIDInterval;
+/* \brief a TIDIntervalPair is a block of a join result, every tid of the first interval matches every tid of the second interval*/
+typedef std::pair<TIDInterval,TIDInterval> TIDIntervalPair;
+typedef std::vector<TIDIntervalPair> TIDIntervalPairList;
+typedef shared_pointer_namespace::shared_ptr<TIDIntervalPairList> TIDIntervalPairListPtr;
+
+/*! \brief expands the blocks of a join result into the pairs of matching tids*/
+inline const PositionListPairPtr toPositionListPair(const TIDIntervalPairList& blocks);
+
+/*!
+ *
+ *
+ *  \brief     This class represents a sorted list of tids as a list of disjoint intervals [begin,end).
+ *  \details   Operators on compressed columns, e.g., a selection on a run length encoded column, produce long ranges of consecutive tids.
+ * 				An interval list stores such a result with two tids per range instead of one tid per row. Adjacent intervals are merged,
+ * 				so the representation is unique. The tids are only expanded into a PositionList when a consumer requests them.
+ * 				The const methods do not modify the list, so several threads may read a shared list at the same time.
+ */
+class PositionIntervalList{
+	public:
+	typedef std::vector<TIDInterval>::const_iterator const_iterator;
+	typedef std::vector<TIDInterval>::const_reverse_iterator const_reverse_iterator;
+	/***************** constructors and destructor *****************/
+	PositionIntervalList();
+	/*! \brief creates the intervals of an ascending sorted PositionList*/
+	explicit PositionIntervalList(const PositionList& tids);
+
+	/*! \brief appends the tids [begin,end), which have to lie behind all tids of the list
+	 *  \details an interval that starts at the end of the last interval extends it*/
+	inline void push_back(TID begin, TID end);
+	/*! \brief returns the number of tids in the list*/
+	size_t size() const throw();
+	bool empty() const throw();
+	/*! \brief returns the number of intervals*/
+	size_t getNumberOfIntervals() const throw();
+	/*! \brief returns the tid on position index without expanding the intervals
+	 *  \details the interval is found with a binary search, a Cursor reads consecutive tids in constant time*/
+	TID operator[](size_t index) const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_reverse_iterator rbegin() const;
+	const_reverse_iterator rend() const;
+	void clear();
+	/*! \brief expands the intervals into a new PositionList, which contains every tid and belongs to the caller*/
+	const PositionListPtr toPositionList() const;
+
+	/*!
+	 *  \brief     A Cursor reads the tids of a list in ascending order without expanding the intervals.
+	 *  \details   The cursor keeps the position of the read, not the list, so every thread reading a shared list uses its own cursor.
+	 */
+	class Cursor{
+		public:
+		/*! \brief places the cursor on the tid at position index of the list*/
+		explicit Cursor(const PositionIntervalList& list, size_t index=0);
+		/*! \brief returns false, if the cursor moved behind the last tid*/
+		inline bool valid() const throw();
+		/*! \brief moves the cursor to the next tid*/
+		inline void next();
+		inline TID getTID() const throw();
+
+		private:
+		const PositionIntervalList& list_;
+		size_t interval_;
+		TID tid_;
+	};
+
+	private:
+	/*! \brief returns the interval that contains the tid at position index*/
+	inline size_t findInterval(size_t index) const;
+
+	std::vector<TIDInterval> intervals_;
+	/*! number of tids in front of each interval*/
+	std::vector<size_t> interval_offsets_;
+	/*! number of tids in all intervals*/
+	size_t number_of_tids_;
+};
+
+/***************** Start of Implementation Section ******************/
+
+	inline PositionIntervalList::PositionIntervalList() : intervals_(), interval_offsets_(), number_of_tids_(0){
+
+	}
+
+	inline PositionIntervalList::PositionIntervalList(const PositionList& tids) : intervals_(), interval_offsets_(), number_of_tids_(0){
+		for(size_t i=0;i<tids.size();++i){
+			push_back(tids[i],tids[i]+1);
+		}
+	}
+
+	inline void PositionIntervalList::push_back(TID begin, TID end){
+		if(begin>=end) return;
+		if(!intervals_.empty() && intervals_.back().second==begin){
+			intervals_.back().second=end;
+		}else{
+			intervals_.push_back(TIDInterval(begin,end));
+			interval_offsets_.push_back(number_of_tids_);
+		}
+		number_of_tids_+=end-begin;
+	}
+
+	inline size_t PositionIntervalList::size() const throw(){
+		return number_of_tids_;
+	}
+
+	inline bool PositionIntervalList::empty() const throw(){
+		return number_of_tids_==0;
+	}
+
+	inline size_t PositionIntervalList::getNumberOfIntervals() const throw(){
+		return intervals_.size();
+	}
+
+	inline size_t PositionIntervalList::findInterval(size_t index) const{
+		return std::upper_bound(interval_offsets_.begin(),interval_offsets_.end(),index)-interval_offsets_.begin()-1;
+	}
+
+	inline TID PositionIntervalList::operator[](size_t index) const{
+		size_t interval = findInterval(index);
+		return TID(intervals_[interval].first+(index-interval_offsets_[interval]));
+	}
+
+	inline PositionIntervalList::const_iterator PositionIntervalList::begin() const{
+		return intervals_.begin();
+	}
+
+	inline PositionIntervalList::const_iterator PositionIntervalList::end() const{
+		return intervals_.end();
+	}
+
+	inline PositionIntervalList::const_reverse_iterator PositionIntervalList::rbegin() const{
+		return intervals_.rbegin();
+	}
+
+	inline PositionIntervalList::const_reverse_iterator PositionIntervalList::rend() const{
+		return intervals_.rend();
+	}
+
+	inline void PositionIntervalList::clear(){
+		intervals_.clear();
+		interval_offsets_.clear();
+		number_of_tids_=0;
+	}
+
+	inline const PositionListPtr PositionIntervalList::toPositionList() const{
+		PositionListPtr tids( new PositionList());
+		tids->reserve(number_of_tids_);
+		for(const_iterator it=intervals_.begin();it!=intervals_.end();++it){
+			for(TID tid=it->first;tid<it->second;++tid){
+				tids->push_back(tid);
+			}
+		}
+		return tids;
+	}
+
+	inline PositionIntervalList::Cursor::Cursor(const PositionIntervalList& list, size_t index) : list_(list), interval_(list.intervals_.size()), tid_(0){
+		if(index<list_.size()){
+			interval_ = list_.findInterval(index);
+			tid_ = TID(list_.intervals_[interval_].first+(index-list_.interval_offsets_[interval_]));
+		}
+	}
+
+	inline bool PositionIntervalList::Cursor::valid() const throw(){
+		return interval_<list_.intervals_.size();
+	}
+
+	inline void PositionIntervalList::Cursor::next(){
+		if(++tid_<list_.intervals_[interval_].second) return;
+		if(++interval_<list_.intervals_.size()){
+			tid_=list_.intervals_[interval_].first;
+		}
+	}
+
+	inline TID PositionIntervalList::Cursor::getTID() const throw(){
+		return tid_;
+	}
+
+	inline const PositionListPairPtr toPositionListPair(const TIDIntervalPairList& blocks){
+		PositionListPairPtr tids( new PositionListPair());
+		tids->first = PositionListPtr( new PositionList() );
+		tids->second = PositionListPtr( new PositionList() );
+		size_t number_of_pairs=0;
+		for(TIDIntervalPairList::const_iterator it=blocks.begin();it!=blocks.end();++it){
+			number_of_pairs+=size_t(it->first.second-it->first.first)*(it->second.second-it->second.first);
+		}
+		tids->first->reserve(number_of_pairs);
+		tids->second->reserve(number_of_pairs);
+		for(TIDIntervalPairList::const_iterator it=blocks.begin();it!=blocks.end();++it){
+			for(TID first=it->first.first;first<it->first.second;++first){
+				for(TID second=it->second.first;second<it->second.second;++second){
+					tids->first->push_back(first);
+					tids->second->push_back(second);
+				}
+			}
+		}
+		return tids;
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
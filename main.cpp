@@ -35,7 +35,31 @@ int main(){
 		std::cout << "At least one Unittest Failed!" << std::endl;	
 		return -1;	
 	} 
-	std::cout << "dict comp Unitests Passed for string!" << std::endl << std::endl << std::endl << std::endl;
+	std::cout << "dict comp Unitests Passed for string!" << std::endl << std::endl;
+
+	if(!test_order_preserving_dictionary<int>() || !test_order_preserving_dictionary<std::string>()){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "dict comp Unitests Passed for order preserving dictionaries!" << std::endl << std::endl;
+
+	if(!test_join_different_dictionaries<int>() || !test_join_different_dictionaries<std::string>()){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "dict comp Unitests Passed for joins of different dictionaries!" << std::endl << std::endl;
+
+	if(!test_parallel_dictionary_insert<int>() || !test_parallel_dictionary_insert<std::string>()){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "dict comp Unitests Passed for parallel inserts!" << std::endl << std::endl;
+
+	if(!test_dictionary_compaction<int>() || !test_dictionary_compaction<std::string>()){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "dict comp Unitests Passed for dictionary compaction!" << std::endl << std::endl << std::endl << std::endl;
 
 ////////---------- RLE------------------------///
 	std::cout <<"RLE compression: "<< std::endl;
@@ -57,19 +81,34 @@ int main(){
 		std::cout << "At least one Unittest Failed!" << std::endl;	
 		return -1;	
 	} 
-	std::cout << "rle comp Unitests Passed for string!" << std::endl << std::endl << std::endl << std::endl;
+	std::cout << "rle comp Unitests Passed for string!" << std::endl << std::endl;
+
+	if(!test_parallel_rle_insert<int>() || !test_parallel_rle_insert<float>() || !test_parallel_rle_insert<std::string>()){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "rle comp Unitests Passed for parallel inserts!" << std::endl << std::endl << std::endl << std::endl;
 
 
 
 ////////---------- Delta------------------------///
 
-    if(!unittest<DeltaCompressedColumn, int>()){
+    if(!unittest<DeltaCompressedColumn, int>() || !test_delta_removes<int>(FIXED_LENGTH_DELTAS)){
 		std::cout << "At least one Unittest Failed!" << std::endl;	
 		return -1;	
 	} 
 	std::cout << "delta comp Unitests Passed for int!" << std::endl << std::endl;
+
+	//the column with variable length deltas is loaded into a column with fixed length deltas, which switches its encoding
+	boost::shared_ptr<DeltaCompressedColumn<int> > varint_col (new DeltaCompressedColumn<int>("int column",INT,VARIABLE_LENGTH_DELTAS));
+	boost::shared_ptr<DeltaCompressedColumn<int> > fixed_col (new DeltaCompressedColumn<int>("int column",INT,FIXED_LENGTH_DELTAS));
+	if(!unittest<DeltaCompressedColumn, int>(varint_col,fixed_col) || !test_variable_length_deltas() || !test_delta_removes<int>(VARIABLE_LENGTH_DELTAS)){
+		std::cout << "At least one Unittest Failed!" << std::endl;	
+		return -1;	
+	} 
+	std::cout << "delta comp Unitests Passed for int with variable length deltas!" << std::endl << std::endl;
    
-	if(!unittest<DeltaCompressedColumn, float>()){
+	if(!unittest<DeltaCompressedColumn, float>() || !test_delta_removes<float>(FIXED_LENGTH_DELTAS)){
 		std::cout << "At least one Unittest Failed!" << std::endl;	
 		return -1;	
 	} 
@@ -15,11 +15,18 @@
 #define UNITTEST_HPP
 
 #include <string>
+#include <deque>
+#include <cmath>
+#include <climits>
 #include <core/global_definitions.hpp>
 #include <core/base_column.hpp>
 #include <core/column_base_typed.hpp>
 #include <core/column.hpp>
 #include <core/compressed_column.hpp>
+#include <core/position_interval_list.hpp>
+#include <compression/dictionary_compressed_column.hpp>
+#include <compression/rle.hpp>
+#include <compression/delta.hpp>
 
 using namespace CoGaDB;
 
@@ -68,23 +75,6 @@ bool equals(std::vector<T> reference_data, boost::shared_ptr<ColumnBaseTyped<T>
 	for (unsigned int i = 0; i < reference_data.size(); i++) {
 		T col_value = (*col)[i];
 
-		if(typeid(T) == typeid(float)) {
-			if(reference_data[i] == col_value) {
-			   reference_data[i] = boost::lexical_cast<double> (reference_data[i]);
-			   col_value = boost::lexical_cast<double> (reference_data[i]);
-			   return true;
-		    }
-		    else {
-		 	   std::cout << "Fatal Error! In Unittest: read invalid data" << std::endl;
-			   std::cout << "Column: '" << col->getName() 
-				<< "' TID: '"<< i 
-				<< "' Expected Value: '" << reference_data[i] 
-				<< "' Actual Value: '" << col_value << "'" 
-				<< std::endl;
-			    return false;
-		    }
-	    }
-
 		if (reference_data[i] != col_value) {
 			std::cout << "Fatal Error! In Unittest: read invalid data" << std::endl;
 			std::cout << "Column: '" << col->getName() 
@@ -98,6 +88,164 @@ bool equals(std::vector<T> reference_data, boost::shared_ptr<ColumnBaseTyped<T>
 	return true;
 }
 
+template<class T>
+bool test_selection(boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	std::cout << "SELECTION TEST: compare results with an uncompressed column...";
+
+	//the uncompressed column holds the decoded values, so the test checks the operator and not the codec
+	std::vector<T> decoded_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+	}
+	boost::shared_ptr<Column<T> > uncompressed_col (new Column<T>(col->getName(),col->getType()));
+	uncompressed_col->insert(decoded_data.begin(),decoded_data.end());
+
+	ValueComparator comparators[] = {EQUAL,LESSER,GREATER};
+	for (unsigned int i = 0; i < 3; i++) {
+		//compare with a value contained in the column and with a random one, which is most likely not contained
+		T values[] = {decoded_data[rand() % decoded_data.size()], get_rand_value<T>()};
+		for (unsigned int j = 0; j < 2; j++) {
+			PositionListPtr expected = uncompressed_col->selection(values[j], comparators[i]);
+			PositionListPtr actual = col->selection(values[j], comparators[i]);
+			if (!actual || *expected != *actual) {
+				std::cout << "Fatal Error! In Unittest: wrong selection result for value '" << values[j]
+					<< "' and comparator '" << comparators[i] << "'" << std::endl;
+				return false;
+			}
+		}
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool test_sort(boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	std::cout << "SORT TEST: compare results with an uncompressed column...";
+
+	std::vector<T> decoded_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+	}
+	boost::shared_ptr<Column<T> > uncompressed_col (new Column<T>(col->getName(),col->getType()));
+	uncompressed_col->insert(decoded_data.begin(),decoded_data.end());
+
+	SortOrder orders[] = {ASCENDING,DESCENDING};
+	for (unsigned int i = 0; i < 2; i++) {
+		PositionListPtr expected = uncompressed_col->sort(orders[i]);
+		PositionListPtr actual = col->sort(orders[i]);
+		if (!actual || *expected != *actual) {
+			std::cout << "Fatal Error! In Unittest: wrong sort result for order '" << orders[i] << "'" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool approximately_equal(const T& value1, const T& value2) {
+	return value1 == value2;
+}
+
+//sums of floats depend on the order of the additions
+template<>
+bool approximately_equal(const float& value1, const float& value2) {
+	return std::fabs(value1 - value2) <= 1e-4 * std::max(std::fabs(value1), std::fabs(value2));
+}
+
+template<class T>
+bool test_aggregate(boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	std::cout << "AGGREGATE TEST: compare results with an uncompressed column...";
+
+	std::vector<T> decoded_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+	}
+	boost::shared_ptr<Column<T> > uncompressed_col (new Column<T>(col->getName(),col->getType()));
+	uncompressed_col->insert(decoded_data.begin(),decoded_data.end());
+
+	PositionListPtr tids = uncompressed_col->selection(decoded_data[rand() % decoded_data.size()], LESSER);
+	AggregationMethod methods[] = {SUM,MIN,MAX};
+	for (unsigned int i = 0; i < 3; i++) {
+		//e.g., a sum of strings is reported as an error
+		if (!is_aggregation_defined<T>(methods[i])) continue;
+		if (!approximately_equal(uncompressed_col->aggregate(methods[i]), col->aggregate(methods[i]))
+			|| !approximately_equal(uncompressed_col->aggregate(methods[i], 10, 60), col->aggregate(methods[i], 10, 60))
+			|| !approximately_equal(uncompressed_col->aggregate(methods[i], tids), col->aggregate(methods[i], tids))) {
+			std::cout << "Fatal Error! In Unittest: wrong result for aggregation method '" << methods[i] << "'" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+std::vector<std::pair<TID,TID> > sorted_join_result(PositionListPairPtr join_tids) {
+	std::vector<std::pair<TID,TID> > result;
+	for (unsigned int i = 0; i < join_tids->first->size(); i++) {
+		result.push_back(std::make_pair((*join_tids->first)[i], (*join_tids->second)[i]));
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+template<class T>
+bool test_join(boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	std::cout << "JOIN TEST: join the column with its copy and compare with an uncompressed column...";
+
+	std::vector<T> decoded_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+	}
+	boost::shared_ptr<Column<T> > uncompressed_col (new Column<T>(col->getName(),col->getType()));
+	uncompressed_col->insert(decoded_data.begin(),decoded_data.end());
+
+	PositionListPairPtr expected = uncompressed_col->hash_join(uncompressed_col->copy());
+	PositionListPairPtr actual = col->hash_join(col->copy());
+	if (sorted_join_result<T>(expected) != sorted_join_result<T>(actual)) {
+		std::cout << "Fatal Error! In Unittest: wrong join result" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool equal_columns(ColumnPtr expected, ColumnPtr actual) {
+	boost::shared_ptr<ColumnBaseTyped<T> > expected_typed = boost::dynamic_pointer_cast<ColumnBaseTyped<T> >(expected);
+	boost::shared_ptr<ColumnBaseTyped<T> > actual_typed = boost::dynamic_pointer_cast<ColumnBaseTyped<T> >(actual);
+	return expected_typed && actual_typed && *expected_typed == *actual_typed;
+}
+
+template<template<typename> class ColumnType, typename T>
+bool test_aggregation(boost::shared_ptr<ColumnType<T> > col) {
+	std::cout << "GROUPBY TEST: aggregate by the column and compare with an uncompressed column...";
+
+	std::vector<T> decoded_data;
+	std::vector<int> aggregated_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+		aggregated_data.push_back(int(i * 7919 % 1000));
+	}
+	Column<T> uncompressed_col(col->getName(),col->getType());
+	uncompressed_col.insert(decoded_data.begin(),decoded_data.end());
+	Column<int> values("values",INT);
+	values.insert(aggregated_data.begin(),aggregated_data.end());
+
+	AggregationMethod methods[] = {SUM,MIN,MAX};
+	for (unsigned int i = 0; i < 3; i++) {
+		std::pair<ColumnPtr,ColumnPtr> expected = uncompressed_col.aggregate_by_keys(values, methods[i]);
+		std::pair<ColumnPtr,ColumnPtr> actual = col->aggregate_by_keys(values, methods[i], 4);
+		if (!equal_columns<T>(expected.first, actual.first) || !equal_columns<int>(expected.second, actual.second)) {
+			std::cout << "Fatal Error! In Unittest: wrong result for aggregation method '" << methods[i] << "'" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
 template<class T>
 bool test_column(boost::shared_ptr<ColumnBaseTyped<T> > col, boost::shared_ptr<ColumnBaseTyped<T> > col_new, std::vector<T>& reference_data) {
 	/****** BASIC INSERT TEST ******/
@@ -162,6 +310,97 @@ bool test_column(boost::shared_ptr<ColumnBaseTyped<T> > col, boost::shared_ptr<C
 		}
 		std::cout << "SUCCESS"<< std::endl;
 	}
+	/****** INTERVAL UPDATE AND DELETE TEST ******/
+	{
+		std::cout << "INTERVAL UPDATE AND DELETE TEST: Update and delete the positions of tid intervals..."; // << std::endl;
+
+		PositionIntervalListPtr tids(new PositionIntervalList());
+		tids->push_back(10, 15);
+		tids->push_back(20, 22);
+		tids->push_back(22, 24);
+		tids->push_back(30, 31);
+		//the intervals read tid by tid, through a cursor and built from their PositionList have to agree
+		PositionListPtr expanded_tids = tids->toPositionList();
+		PositionIntervalList rebuilt_tids(*expanded_tids);
+		PositionIntervalList::Cursor cursor(*tids);
+		for (unsigned int i = 0; i < expanded_tids->size(); i++, cursor.next()) {
+			if (!cursor.valid() || cursor.getTID() != (*expanded_tids)[i] || (*tids)[i] != (*expanded_tids)[i] || rebuilt_tids[i] != (*expanded_tids)[i]) {
+				std::cerr << "INTERVAL LIST TEST FAILED!" << std::endl;
+				return false;
+			}
+		}
+		if (cursor.valid() || tids->getNumberOfIntervals() != 3 || rebuilt_tids.getNumberOfIntervals() != 3 || tids->size() != 10) {
+			std::cerr << "INTERVAL LIST TEST FAILED!" << std::endl;
+			return false;
+		}
+		T new_value = get_rand_value<T>();
+		for (PositionIntervalList::const_iterator it = tids->begin(); it != tids->end(); ++it) {
+			std::fill(reference_data.begin() + it->first, reference_data.begin() + it->second, new_value);
+		}
+		col->update(tids, new_value);
+		if (!equals(reference_data, col)) {
+			std::cerr << "INTERVAL UPDATE TEST FAILED!" << std::endl;
+			return false;
+		}
+
+		reference_data.erase(reference_data.begin() + 30, reference_data.begin() + 31);
+		reference_data.erase(reference_data.begin() + 20, reference_data.begin() + 24);
+		reference_data.erase(reference_data.begin() + 10, reference_data.begin() + 15);
+		col->remove(tids);
+		if (!equals(reference_data, col)) {
+			std::cerr << "INTERVAL DELETE TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** INTERVAL BULK UPDATE AND DELETE TEST ******/
+	{
+		std::cout << "INTERVAL BULK UPDATE AND DELETE TEST: Update and delete nine of ten rows of a copy through many intervals..."; // << std::endl;
+
+		boost::shared_ptr<ColumnBaseTyped<T> > copy_col = boost::static_pointer_cast<ColumnBaseTyped<T> >(col->copy());
+		std::vector<T> copy_data(reference_data);
+		PositionIntervalListPtr tids(new PositionIntervalList());
+		for (TID tid = 0; tid + 10 <= copy_data.size(); tid += 10) {
+			tids->push_back(tid + 1, tid + 10);
+		}
+		T new_value = get_rand_value<T>();
+		for (PositionIntervalList::const_iterator it = tids->begin(); it != tids->end(); ++it) {
+			std::fill(copy_data.begin() + it->first, copy_data.begin() + it->second, new_value);
+		}
+		if (!copy_col->update(tids, new_value) || !equals(copy_data, copy_col)) {
+			std::cerr << "INTERVAL BULK UPDATE TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::vector<T> remaining_data;
+		for (size_t i = 0; i < copy_data.size(); i++) {
+			if (i % 10 == 0 || i >= tids->rbegin()->second) remaining_data.push_back(copy_data[i]);
+		}
+		if (!copy_col->remove(tids) || !equals(remaining_data, copy_col)) {
+			std::cerr << "INTERVAL BULK DELETE TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SELECTION TEST ******/
+	if (!test_selection(col)) {
+		std::cerr << "SELECTION TEST FAILED!" << std::endl;
+		return false;
+	}
+	/****** JOIN TEST ******/
+	if (!test_join(col)) {
+		std::cerr << "JOIN TEST FAILED!" << std::endl;
+		return false;
+	}
+	/****** SORT TEST ******/
+	if (!test_sort(col)) {
+		std::cerr << "SORT TEST FAILED!" << std::endl;
+		return false;
+	}
+	/****** AGGREGATE TEST ******/
+	if (!test_aggregate(col)) {
+		std::cerr << "AGGREGATE TEST FAILED!" << std::endl;
+		return false;
+	}
 	/****** STORE AND LOAD TEST ******/
 	{
 		std::cout << "STORE AND LOAD TEST: store column data on disc and load it..."; // << std::endl;
@@ -223,19 +462,454 @@ std::string  getAttributeString<std::string>(){
     return "string column";
 }
 
+/*! \brief returns up to number_of_values distinct random values in ascending order*/
+template<class T>
+std::vector<T> get_distinct_values(unsigned int number_of_values) {
+	std::vector<T> values;
+	for (unsigned int i = 0; i < number_of_values; i++) {
+		values.push_back(get_rand_value<T>());
+	}
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+	return values;
+}
+
+template<class T>
+boost::shared_ptr<Column<T> > get_uncompressed_column(boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	std::vector<T> decoded_data;
+	for (unsigned int i = 0; i < col->size(); i++) {
+		decoded_data.push_back((*col)[i]);
+	}
+	boost::shared_ptr<Column<T> > uncompressed_col (new Column<T>(col->getName(),col->getType()));
+	uncompressed_col->insert(decoded_data.begin(),decoded_data.end());
+	return uncompressed_col;
+}
+
+/*! \brief compares the range selections of the column for every value in values with the generic scan of an uncompressed column*/
+template<class T>
+bool test_range_selections(boost::shared_ptr<ColumnBaseTyped<T> > col, const std::vector<T>& values) {
+	boost::shared_ptr<Column<T> > uncompressed_col = get_uncompressed_column<T>(col);
+	ValueComparator comparators[] = {LESSER,GREATER};
+	for (unsigned int i = 0; i < 2; i++) {
+		for (unsigned int j = 0; j < values.size(); j++) {
+			PositionListPtr expected = uncompressed_col->selection(values[j], comparators[i]);
+			PositionListPtr actual = col->selection(values[j], comparators[i]);
+			if (!actual || *expected != *actual) {
+				std::cout << "Fatal Error! In Unittest: wrong selection result for value '" << values[j]
+					<< "' and comparator '" << comparators[i] << "'" << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template<class T>
+bool test_order_preserving_dictionary() {
+	//the sort test reports its own result, so the test name gets its own line
+	std::cout << "ORDER PRESERVING DICTIONARY TEST: compare range selections and sorting with an uncompressed column..." << std::endl;
+	boost::shared_ptr<DictionaryCompressedColumn<T> > col (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+	std::vector<T> values = get_distinct_values<T>(200);
+	//the bulk load uses every second value, the values in between do not fit behind the codes of the loaded values
+	std::vector<T> loaded_values, missing_values;
+	for (unsigned int i = 0; i < values.size(); i++) {
+		(i % 2 == 0 ? loaded_values : missing_values).push_back(values[i]);
+	}
+	std::vector<T> rows;
+	for (unsigned int i = 0; i < 1000; i++) {
+		rows.push_back(loaded_values[rand() % loaded_values.size()]);
+	}
+	col->insert(rows.begin(), rows.end());
+	if (!col->isOrderPreserving() || !test_range_selections<T>(col, values)) {
+		std::cout << "Fatal Error! In Unittest: bulk load did not create an order preserving dictionary" << std::endl;
+		return false;
+	}
+	//values, which are already in the dictionary, keep the order
+	for (unsigned int i = 0; i < 100; i++) {
+		col->insert(loaded_values[rand() % loaded_values.size()]);
+	}
+	if (!col->isOrderPreserving() || !test_range_selections<T>(col, values)) {
+		std::cout << "Fatal Error! In Unittest: inserting known values broke the order" << std::endl;
+		return false;
+	}
+	//new values in between the known ones break the order, the selection has to evaluate the predicate per code
+	for (unsigned int i = 0; i < 100; i++) {
+		col->insert(missing_values[rand() % missing_values.size()]);
+	}
+	if (col->isOrderPreserving() || !test_range_selections<T>(col, values) || !test_sort<T>(col)) {
+		std::cout << "Fatal Error! In Unittest: wrong result after the order was broken" << std::endl;
+		return false;
+	}
+	std::vector<T> reference_data = get_uncompressed_column<T>(col)->getContent();
+	col->makeOrderPreserving();
+	if (!col->isOrderPreserving() || !equals<T>(reference_data, col)
+		|| !test_range_selections<T>(col, values) || !test_sort<T>(col)) {
+		std::cout << "Fatal Error! In Unittest: wrong result after the dictionary was reordered" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool test_join_different_dictionaries() {
+	std::cout << "JOIN TEST: join two columns with different dictionaries and compare with uncompressed columns...";
+	std::vector<T> values = get_distinct_values<T>(300);
+	//the first column gets the lower two thirds of the values, the second the upper two thirds, so only the middle third matches
+	const unsigned int number_of_values = values.size();
+	boost::shared_ptr<DictionaryCompressedColumn<T> > col_one (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+	boost::shared_ptr<DictionaryCompressedColumn<T> > col_two (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+	for (unsigned int i = 0; i < 500; i++) {
+		col_one->insert(values[rand() % (2 * number_of_values / 3)]);
+		col_two->insert(values[number_of_values / 3 + rand() % (number_of_values - number_of_values / 3)]);
+	}
+	//removed rows leave free codes in the dictionary of the second column
+	for (unsigned int i = 0; i < 50; i++) {
+		col_two->remove(rand() % col_two->size());
+	}
+	if (col_one->getDictionary() == col_two->getDictionary()) {
+		std::cout << "Fatal Error! In Unittest: the columns share their dictionary" << std::endl;
+		return false;
+	}
+	boost::shared_ptr<Column<T> > uncompressed_one = get_uncompressed_column<T>(col_one);
+	boost::shared_ptr<Column<T> > uncompressed_two = get_uncompressed_column<T>(col_two);
+	if (sorted_join_result<T>(uncompressed_one->hash_join(uncompressed_two)) != sorted_join_result<T>(col_one->hash_join(col_two))
+		|| sorted_join_result<T>(uncompressed_two->hash_join(uncompressed_one)) != sorted_join_result<T>(col_two->hash_join(col_one))) {
+		std::cout << "Fatal Error! In Unittest: wrong join result" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool test_parallel_dictionary_insert() {
+	std::cout << "PARALLEL INSERT TEST: compare a parallel bulk insert with a row by row insert...";
+	std::vector<T> values = get_distinct_values<T>(1000);
+	//enough rows for four threads, which start at multiples of 64 rows, the odd row count leaves a short last part
+	std::vector<T> reference_data(4 * 64 * 1024 + 1001);
+	for (unsigned int i = 0; i < reference_data.size(); i++) {
+		reference_data[i] = values[rand() % values.size()];
+	}
+	//the second bulk insert appends behind 100 rows, so the first part does not start at a word boundary of the codes
+	const unsigned int number_of_prefix_rows = 100;
+	for (unsigned int number_of_rows_before = 0; number_of_rows_before <= number_of_prefix_rows; number_of_rows_before += number_of_prefix_rows) {
+		boost::shared_ptr<DictionaryCompressedColumn<T> > parallel_col (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+		boost::shared_ptr<DictionaryCompressedColumn<T> > sequential_col (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+		for (unsigned int i = 0; i < number_of_rows_before; i++) {
+			parallel_col->insert(reference_data[i]);
+		}
+		parallel_col->insert(reference_data.begin() + number_of_rows_before, reference_data.end(), 4);
+		for (unsigned int i = 0; i < reference_data.size(); i++) {
+			sequential_col->insert(reference_data[i]);
+		}
+		//every distinct value has to get exactly one code, even if it occurs in the parts of several threads
+		if (parallel_col->size() != reference_data.size() || parallel_col->getDictionary()->size() != sequential_col->getDictionary()->size()) {
+			std::cout << "Fatal Error! In Unittest: invalid data or dictionary size" << std::endl;
+			return false;
+		}
+		if (!equals<T>(reference_data, parallel_col) || !(*parallel_col == *sequential_col)) {
+			std::cout << "Fatal Error! In Unittest: parallel insert behind " << number_of_rows_before << " rows differs from the row by row insert" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+template<class T>
+bool test_dictionary_compaction() {
+	std::cout << "DICTIONARY COMPACTION TEST: update and remove rows, then compact the dictionary...";
+	std::vector<T> distinct_values = get_distinct_values<T>(2000);
+	//values of different lengths, so that a string is replaced by a longer one as well
+	std::vector<T> values;
+	for (unsigned int i = 0; i < distinct_values.size(); i++) {
+		values.push_back(i % 2 == 0 ? distinct_values[i] : distinct_values[i] + distinct_values[i / 2]);
+	}
+	boost::shared_ptr<DictionaryCompressedColumn<T> > col (new DictionaryCompressedColumn<T>(getAttributeString<T>(),getAttributeType<T>()));
+	std::vector<T> reference_data;
+	for (unsigned int i = 0; i < 200; i++) {
+		reference_data.push_back(values[rand() % values.size()]);
+		col->insert(reference_data.back());
+	}
+	//the codes of replaced values are reused, so the dictionary never holds much more values than there are rows
+	for (unsigned int i = 0; i < 20000; i++) {
+		TID tid = rand() % reference_data.size();
+		T value = values[rand() % values.size()];
+		if (i % 2 == 0) {
+			col->update(tid, value);
+			reference_data[tid] = value;
+		} else {
+			col->remove(tid);
+			reference_data.erase(reference_data.begin() + tid);
+			col->insert(value);
+			reference_data.push_back(value);
+		}
+		if (col->getDictionary()->size() > reference_data.size() + 1) {
+			std::cout << "Fatal Error! In Unittest: the dictionary grows under updates, it has "
+				<< col->getDictionary()->size() << " codes for " << reference_data.size() << " rows" << std::endl;
+			return false;
+		}
+	}
+	if (!equals<T>(reference_data, col)) {
+		return false;
+	}
+	//after removing most rows, the compaction drops the free codes and narrows the codes of the remaining rows
+	while (reference_data.size() > 10) {
+		TID tid = rand() % reference_data.size();
+		col->remove(tid);
+		reference_data.erase(reference_data.begin() + tid);
+	}
+	const unsigned int bits_per_value = col->getContent().getBitsPerValue();
+	//a column sharing the dictionary prevents the compaction
+	{
+		DictionaryCompressedColumn<T> shared_col(getAttributeString<T>(), getAttributeType<T>(), col->getDictionary());
+		if (col->compactDictionary() || col->getContent().getBitsPerValue() != bits_per_value) {
+			std::cout << "Fatal Error! In Unittest: compacted a shared dictionary" << std::endl;
+			return false;
+		}
+	}
+	if (!col->compactDictionary() || col->getDictionary()->getNumberOfFreeCodes() != 0
+		|| col->getDictionary()->size() > reference_data.size() || col->getContent().getBitsPerValue() >= bits_per_value) {
+		std::cout << "Fatal Error! In Unittest: the compaction did not shrink the dictionary" << std::endl;
+		return false;
+	}
+	if (!equals<T>(reference_data, col) || !test_range_selections<T>(col, values)) {
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+/*! \brief returns true, if both columns consist of the same runs*/
+template<class T>
+bool equal_runs(rleCompressedColumn<T>& col_one, rleCompressedColumn<T>& col_two) {
+	if (col_one.getContent().getNumberOfRuns() != col_two.getContent().getNumberOfRuns()) {
+		return false;
+	}
+	typename RunTree<T>::Cursor run_two = col_two.getContent().begin();
+	for (typename RunTree<T>::Cursor run_one = col_one.getContent().begin(); run_one.valid(); run_one.next(), run_two.next()) {
+		if (!run_two.valid() || run_one.value() != run_two.value() || run_one.getRunEnd() != run_two.getRunEnd()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<class T>
+bool test_parallel_rle_insert() {
+	std::cout << "PARALLEL INSERT TEST: compare a parallel bulk insert with the sequential encoding...";
+	std::vector<T> values = get_distinct_values<T>(20);
+	//enough rows for four threads, the runs have lengths between 1 and 13, so most do not fill whole vector registers
+	std::vector<T> reference_data;
+	while (reference_data.size() < 4 * 64 * 1024 + 1003) {
+		reference_data.insert(reference_data.end(), 1 + rand() % 13, values[rand() % values.size()]);
+	}
+	//a run across the border of every part, the parts of four threads start at multiples of a quarter of the rows
+	const unsigned int rows_per_thread = (reference_data.size() + 3) / 4;
+	for (unsigned int t = 1; t < 4; t++) {
+		std::fill(reference_data.begin() + t * rows_per_thread - 7, reference_data.begin() + t * rows_per_thread + 6 + t, values[t % values.size()]);
+	}
+	rleCompressedColumn<T> sequential_col(getAttributeString<T>(), getAttributeType<T>());
+	sequential_col.insert(reference_data.begin(), reference_data.end(), 1);
+	//a vector is searched with vector instructions, a deque with the generic comparison
+	rleCompressedColumn<T> parallel_col(getAttributeString<T>(), getAttributeType<T>());
+	parallel_col.insert(reference_data.begin(), reference_data.end(), 4);
+	std::deque<T> deque_data(reference_data.begin(), reference_data.end());
+	rleCompressedColumn<T> deque_col(getAttributeString<T>(), getAttributeType<T>());
+	deque_col.insert(deque_data.begin(), deque_data.end(), 4);
+	for (unsigned int i = 0; i < reference_data.size(); i++) {
+		if (sequential_col[i] != reference_data[i]) {
+			std::cout << "Fatal Error! In Unittest: wrong value in row " << i << " of the sequential encoding" << std::endl;
+			return false;
+		}
+	}
+	if (!equal_runs(sequential_col, parallel_col) || !equal_runs(sequential_col, deque_col)) {
+		std::cout << "Fatal Error! In Unittest: the parallel encoding differs from the sequential encoding" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+/*! \brief compares every row of the column and reads of number_of_values rows from several positions with the reference data*/
+template<class T>
+bool equals_block_reads(const std::vector<T>& reference_data, boost::shared_ptr<DeltaCompressedColumn<T> > col, size_t number_of_values) {
+	if (!equals<T>(reference_data, col)) {
+		return false;
+	}
+	std::vector<T> values(number_of_values);
+	for (size_t begin = 0; begin + number_of_values <= reference_data.size(); begin += 61) {
+		col->getValues(begin, number_of_values, &values[0]);
+		if (!std::equal(values.begin(), values.end(), reference_data.begin() + begin)) {
+			std::cout << "Fatal Error! In Unittest: wrong values read from row " << begin << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_variable_length_deltas() {
+	std::cout << "VARIABLE LENGTH DELTA TEST: deltas of extreme values, reads across blocks, updates, deletes and store and load...";
+	boost::shared_ptr<DeltaCompressedColumn<int> > col (new DeltaCompressedColumn<int>("int column", INT, VARIABLE_LENGTH_DELTAS));
+	//mostly small deltas, which take one byte, and jumps between the extreme values, whose deltas take five bytes
+	const int extreme_values[] = {INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1, 0, -1, 1 << 20, -(1 << 27)};
+	std::vector<int> reference_data;
+	int value = 0;
+	for (unsigned int i = 0; i < 1000; i++) {
+		if (i % 7 == 0) {
+			value = extreme_values[rand() % 8];
+		} else {
+			value = int((unsigned int)value + (unsigned int)(rand() % 129 - 64));
+		}
+		reference_data.push_back(value);
+		col->insert(value);
+	}
+	//the reads cross the borders of the blocks
+	if (!equals_block_reads(reference_data, col, 300)) {
+		return false;
+	}
+	//updates and deletes in a middle block and in the last block
+	const TID tids[] = {200, TID(reference_data.size() - 1), 300, TID(reference_data.size() - 2)};
+	for (unsigned int i = 0; i < 4; i++) {
+		const int new_value = extreme_values[i];
+		col->update(tids[i], new_value);
+		reference_data[tids[i]] = new_value;
+	}
+	if (!equals_block_reads(reference_data, col, 300)) {
+		std::cout << "Fatal Error! In Unittest: wrong values after updates" << std::endl;
+		return false;
+	}
+	const TID removed_tids[] = {TID(reference_data.size() - 1), 250, 129, TID(reference_data.size() - 5)};
+	for (unsigned int i = 0; i < 4; i++) {
+		col->remove(removed_tids[i]);
+		reference_data.erase(reference_data.begin() + removed_tids[i]);
+	}
+	//a whole block of rows is removed, and rows are appended behind the changed last block
+	PositionListPtr tids_of_block(new PositionList());
+	for (TID tid = 400; tid < 600; tid++) {
+		tids_of_block->push_back(tid);
+	}
+	col->remove(tids_of_block);
+	reference_data.erase(reference_data.begin() + 400, reference_data.begin() + 600);
+	for (unsigned int i = 0; i < 100; i++) {
+		reference_data.push_back(extreme_values[i % 8]);
+		col->insert(reference_data.back());
+	}
+	if (!equals_block_reads(reference_data, col, 300)) {
+		std::cout << "Fatal Error! In Unittest: wrong values after deletes" << std::endl;
+		return false;
+	}
+	//a column with fixed length deltas switches to the stored encoding
+	col->store("data/");
+	boost::shared_ptr<DeltaCompressedColumn<int> > loaded_col (new DeltaCompressedColumn<int>("int column", INT, FIXED_LENGTH_DELTAS));
+	loaded_col->load("data/");
+	if (loaded_col->getEncoding() != VARIABLE_LENGTH_DELTAS || !equals_block_reads(reference_data, loaded_col, 300)) {
+		std::cout << "Fatal Error! In Unittest: wrong column after store and load" << std::endl;
+		return false;
+	}
+	//a column of ascending values with deltas below 64 takes a single byte per row and its share of the block headers
+	boost::shared_ptr<DeltaCompressedColumn<int> > sorted_col (new DeltaCompressedColumn<int>("int column", INT, VARIABLE_LENGTH_DELTAS));
+	value = 0;
+	for (unsigned int i = 0; i < 100000; i++) {
+		value += rand() % 64;
+		sorted_col->insert(value);
+	}
+	//a loaded column has no spare capacity in its buffers
+	sorted_col->store("data/");
+	DeltaCompressedColumn<int> loaded_sorted_col("int column", INT, VARIABLE_LENGTH_DELTAS);
+	loaded_sorted_col.load("data/");
+	if (loaded_sorted_col.size() != sorted_col->size() || loaded_sorted_col.getSizeinBytes() > 1.25 * loaded_sorted_col.size()) {
+		std::cout << "Fatal Error! In Unittest: " << loaded_sorted_col.getSizeinBytes() << " bytes for " << loaded_sorted_col.size() << " rows with small deltas" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+/*! \brief removes rows one by one and in bulk, so blocks fall below half of their capacity and are merged with their neighbours*/
+template<class T>
+bool test_delta_removes(DeltaEncoding encoding) {
+	std::cout << "DELTA REMOVE TEST: single and bulk removes, merges of blocks...";
+	boost::shared_ptr<DeltaCompressedColumn<T> > col (new DeltaCompressedColumn<T>(getAttributeString<T>(), getAttributeType<T>(), encoding));
+	std::vector<T> reference_data;
+	for (unsigned int i = 0; i < 20000; i++) {
+		reference_data.push_back(get_rand_value<T>());
+		col->insert(reference_data.back());
+	}
+	//every second row of the first half, a range of rows and the rows behind the last row, which are ignored
+	PositionListPtr tids(new PositionList());
+	for (TID tid = 0; tid < 10000; tid += 2) {
+		tids->push_back(tid);
+	}
+	for (TID tid = 12000; tid < 13000; tid++) {
+		tids->push_back(tid);
+	}
+	tids->push_back(TID(reference_data.size()));
+	col->remove(tids);
+	std::vector<T> remaining_data;
+	for (size_t i = 0; i < reference_data.size(); i++) {
+		if ((i < 10000 && i % 2 == 0) || (i >= 12000 && i < 13000)) continue;
+		remaining_data.push_back(reference_data[i]);
+	}
+	reference_data.swap(remaining_data);
+	if (!equals_block_reads(reference_data, col, 300)) {
+		std::cout << "Fatal Error! In Unittest: wrong values after bulk remove" << std::endl;
+		return false;
+	}
+	//19 of 20 rows are removed at random positions
+	while (reference_data.size() > 700) {
+		const TID tid = TID(rand() % reference_data.size());
+		col->remove(tid);
+		reference_data.erase(reference_data.begin() + tid);
+	}
+	if (!equals_block_reads(reference_data, col, 300)) {
+		std::cout << "Fatal Error! In Unittest: wrong values after removes" << std::endl;
+		return false;
+	}
+	//the merged blocks are at least half full, so the column takes at most twice the memory of a column with the same rows in full blocks
+	boost::shared_ptr<DeltaCompressedColumn<T> > full_col (new DeltaCompressedColumn<T>(getAttributeString<T>(), getAttributeType<T>(), encoding));
+	for (size_t i = 0; i < reference_data.size(); i++) {
+		full_col->insert(reference_data[i]);
+	}
+	//loaded columns have no spare capacity in their buffers
+	col->store("data/");
+	DeltaCompressedColumn<T> loaded_col(getAttributeString<T>(), getAttributeType<T>(), encoding);
+	loaded_col.load("data/");
+	full_col->store("data/");
+	DeltaCompressedColumn<T> loaded_full_col(getAttributeString<T>(), getAttributeType<T>(), encoding);
+	loaded_full_col.load("data/");
+	if (loaded_col.getSizeinBytes() > 2 * loaded_full_col.getSizeinBytes()) {
+		std::cout << "Fatal Error! In Unittest: " << loaded_col.getSizeinBytes() << " bytes after removes, " << loaded_full_col.getSizeinBytes() << " bytes in full blocks" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
+/*! \brief runs the unit tests on col_one, col_two is the column the stored col_one is loaded into*/
 template<template<typename> class ColumnType, typename ValueType>
-bool unittest() {
+bool unittest(boost::shared_ptr<ColumnType<ValueType> > col_one, boost::shared_ptr<ColumnType<ValueType> > col_two) {
 	std::cout << "RUN Unittest for Column with BaseType ColumnBaseTyped<int> >" << std::endl;
-        
-         boost::shared_ptr<ColumnType<ValueType> > col_one (new ColumnType<ValueType>(getAttributeString<ValueType>(),getAttributeType<ValueType>()));
-         boost::shared_ptr<ColumnType<ValueType> > col_two (new ColumnType<ValueType>(getAttributeString<ValueType>(),getAttributeType<ValueType>()));
 	
-	std::vector<ValueType> reference_data(100);
+	//more rows than one block of the block based codecs
+	std::vector<ValueType> reference_data(300);
 
 	fill_column<ValueType>(col_one, reference_data);
+	if (!test_aggregation<ColumnType,ValueType>(col_one)) {
+		std::cout << "GROUPBY TEST FAILED" << std::endl;
+		return false;
+	}
 	return test_column<ValueType>(col_one, col_two, reference_data);
 }
 
+template<template<typename> class ColumnType, typename ValueType>
+bool unittest() {
+	boost::shared_ptr<ColumnType<ValueType> > col_one (new ColumnType<ValueType>(getAttributeString<ValueType>(),getAttributeType<ValueType>()));
+	boost::shared_ptr<ColumnType<ValueType> > col_two (new ColumnType<ValueType>(getAttributeString<ValueType>(),getAttributeType<ValueType>()));
+	return unittest<ColumnType,ValueType>(col_one, col_two);
+}
+
 
 
 